@@ -0,0 +1,58 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/adaptivetimestep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace smash {
+
+AdaptiveTimeStep::AdaptiveTimeStep(double min_dt, double max_dt,
+                                   double force_safety_factor,
+                                   double max_interactions_per_particle,
+                                   double growth_factor)
+    : min_dt_(min_dt),
+      max_dt_(max_dt),
+      force_safety_factor_(force_safety_factor),
+      max_interactions_per_particle_(max_interactions_per_particle),
+      growth_factor_(growth_factor) {
+  if (!(min_dt_ > 0.) || max_dt_ < min_dt_) {
+    throw std::invalid_argument(
+        "The adaptive time step needs 0 < Min_Delta_Time <= Max_Delta_Time.");
+  }
+  if (!(force_safety_factor_ > 0.) || !(max_interactions_per_particle_ > 0.)) {
+    throw std::invalid_argument(
+        "Force_Safety_Factor and Max_Interactions_Per_Particle have to be "
+        "positive.");
+  }
+  if (!(growth_factor_ >= 1.)) {
+    throw std::invalid_argument("Growth_Factor must not be smaller than 1.");
+  }
+}
+
+double AdaptiveTimeStep::next_timestep(double dt, double force_time_scale,
+                                       uint64_t interactions,
+                                       std::size_t n_particles) const {
+  double limit = max_dt_;
+  if (std::isfinite(force_time_scale)) {
+    limit = std::min(limit, force_safety_factor_ * force_time_scale);
+  }
+  if (interactions > 0 && n_particles > 0 && dt > 0.) {
+    // interactions per particle and fm/c
+    const double rate = interactions / (n_particles * dt);
+    limit = std::min(limit, max_interactions_per_particle_ / rate);
+  }
+  // Shrink at once, but grow gradually.
+  const double next_dt = std::min(limit, growth_factor_ * dt);
+  return std::max(next_dt, min_dt_);
+}
+
+}  // namespace smash
@@ -0,0 +1,246 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/allocationpool.h"
+
+#include <array>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace smash {
+namespace allocation_pool {
+
+namespace {
+
+/// Block sizes are multiples of this number of bytes.
+constexpr std::size_t granularity = 16;
+
+/// Number of block sizes; larger blocks are not recycled.
+constexpr std::size_t number_of_sizes = 64;
+
+/// Number of free blocks moved at once between a thread and the depot.
+constexpr std::size_t batch_size = 256;
+
+/// Maximal number of free blocks that a thread keeps per block size.
+constexpr std::size_t max_free_blocks = 2 * batch_size;
+
+/// Maximal number of batches that the depot keeps per block size.
+constexpr std::size_t max_depot_batches = 64;
+
+/// A free block, which stores the pointer to the next free block.
+struct FreeBlock {
+  /// Next free block of the same size, nullptr if this is the last one.
+  FreeBlock *next;
+};
+
+/**
+ * Releases a chain of free blocks.
+ * \param[in] block First block of the chain.
+ */
+void release(FreeBlock *block) {
+  while (block != nullptr) {
+    FreeBlock *next = block->next;
+    ::operator delete(block);
+    block = next;
+  }
+}
+
+/// A chain of free blocks and its length.
+struct Batch {
+  /// First block of the chain.
+  FreeBlock *head;
+  /// Number of blocks in the chain.
+  std::size_t count;
+};
+
+/**
+ * The free blocks shared by all threads. Threads hand over the blocks they
+ * have too many of and the blocks they keep when they exit, and take them
+ * from here before allocating new ones. Blocks therefore return to the
+ * threads that allocate, even if they are freed by another thread and the
+ * allocating threads are short-lived.
+ */
+class Depot {
+ public:
+  /// Releases all kept blocks.
+  ~Depot() {
+    destroyed = true;
+    for (auto &batches : batches_) {
+      for (const Batch &batch : batches) {
+        release(batch.head);
+      }
+    }
+  }
+
+  /**
+   * \return A batch of free blocks of size class \p i, with a nullptr head
+   * if there is none.
+   * \param[in] i Size class.
+   */
+  Batch take(std::size_t i) {
+    if (destroyed) {
+      return {nullptr, 0};
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (batches_[i].empty()) {
+      return {nullptr, 0};
+    }
+    const Batch batch = batches_[i].back();
+    batches_[i].pop_back();
+    return batch;
+  }
+
+  /**
+   * Keeps a batch of free blocks of size class \p i, or releases it if
+   * there are enough already.
+   * \param[in] batch The blocks.
+   * \param[in] i Size class.
+   */
+  void give(Batch batch, std::size_t i) {
+    if (!destroyed) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (batches_[i].size() < max_depot_batches) {
+        batches_[i].push_back(batch);
+        return;
+      }
+    }
+    release(batch.head);
+  }
+
+  /**
+   * Whether the depot was destroyed already, at the end of the program.
+   * Threads still hand over or take blocks afterwards, e.g. in the
+   * destructors of other static objects.
+   */
+  static bool destroyed;
+
+ private:
+  /// Protects the batches.
+  std::mutex mutex_;
+  /// Batches of free blocks of every size class.
+  std::array<std::vector<Batch>, number_of_sizes> batches_;
+};
+
+bool Depot::destroyed = false;
+
+/// The depot of all threads.
+Depot depot;
+
+/// The free blocks of one thread.
+class FreeLists {
+ public:
+  /// Hands all kept blocks over to the depot.
+  ~FreeLists() {
+    for (std::size_t i = 0; i < number_of_sizes; ++i) {
+      if (heads_[i] != nullptr) {
+        depot.give({heads_[i], counts_[i]}, i);
+      }
+    }
+    destroyed = true;
+  }
+
+  /**
+   * \return A free block of size class \p i, or nullptr if neither this
+   * thread nor the depot have one.
+   * \param[in] i Size class.
+   */
+  void *take(std::size_t i) {
+    if (heads_[i] == nullptr) {
+      const Batch batch = depot.take(i);
+      heads_[i] = batch.head;
+      counts_[i] = batch.count;
+    }
+    FreeBlock *block = heads_[i];
+    if (block != nullptr) {
+      heads_[i] = block->next;
+      --counts_[i];
+    }
+    return block;
+  }
+
+  /**
+   * Keeps a block of size class \p i for reuse. If there are too many, a
+   * batch of them is handed over to the depot first.
+   * \param[in] pointer The block.
+   * \param[in] i Size class.
+   */
+  void keep(void *pointer, std::size_t i) {
+    if (counts_[i] >= max_free_blocks) {
+      FreeBlock *last = heads_[i];
+      for (std::size_t n = 1; n < batch_size; ++n) {
+        last = last->next;
+      }
+      const Batch batch = {heads_[i], batch_size};
+      heads_[i] = last->next;
+      last->next = nullptr;
+      counts_[i] -= batch_size;
+      depot.give(batch, i);
+    }
+    FreeBlock *block = new (pointer) FreeBlock;
+    block->next = heads_[i];
+    heads_[i] = block;
+    ++counts_[i];
+  }
+
+  /**
+   * Whether the free lists of the current thread were destroyed already.
+   * Objects can still be freed afterwards, e.g. by the destructors of other
+   * thread-local or static objects.
+   */
+  static thread_local bool destroyed;
+
+ private:
+  /// First free block of every size class.
+  std::array<FreeBlock *, number_of_sizes> heads_ = {};
+  /// Number of free blocks of every size class.
+  std::array<std::size_t, number_of_sizes> counts_ = {};
+};
+
+thread_local bool FreeLists::destroyed = false;
+
+/// The free lists of the current thread.
+thread_local FreeLists free_lists;
+
+/**
+ * \return The size class of blocks of \p size bytes.
+ * \param[in] size Number of bytes.
+ */
+std::size_t size_class(std::size_t size) {
+  // Every block must be able to hold a FreeBlock.
+  return size == 0 ? 1 : (size + granularity - 1) / granularity;
+}
+
+}  // unnamed namespace
+
+void *allocate(std::size_t size) {
+  const std::size_t i = size_class(size);
+  if (i < number_of_sizes && !FreeLists::destroyed) {
+    void *block = free_lists.take(i);
+    if (block != nullptr) {
+      return block;
+    }
+    // Allocate the full block size, so it can be reused for all sizes of
+    // this class.
+    return ::operator new(i * granularity);
+  }
+  return ::operator new(size);
+}
+
+void deallocate(void *pointer, std::size_t size) noexcept {
+  const std::size_t i = size_class(size);
+  if (pointer != nullptr && i < number_of_sizes && !FreeLists::destroyed) {
+    free_lists.keep(pointer, i);
+    return;
+  }
+  ::operator delete(pointer);
+}
+
+}  // namespace allocation_pool
+}  // namespace smash
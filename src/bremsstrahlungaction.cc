@@ -8,6 +8,9 @@
  */
 
 #include "smash/bremsstrahlungaction.h"
+
+#include <mutex>
+
 #include "smash/crosssectionsbrems.h"
 #include "smash/outputinterface.h"
 #include "smash/random.h"
@@ -184,11 +187,10 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
   static const ParticleTypePtr pi_p_particle = &ParticleType::find(pdg::pi_p);
   static const ParticleTypePtr pi_m_particle = &ParticleType::find(pdg::pi_m);
 
-  // Create interpolation objects, if not yet existent; only trigger for one
-  // of them as either all or none is created
-  if (pi0pi0_pipi_dsigma_dtheta_interpolation == nullptr) {
-    create_interpolations();
-  }
+  // Create interpolation objects exactly once, also if several threads get
+  // here at the same time; afterwards they are only read
+  static std::once_flag interpolations_created;
+  std::call_once(interpolations_created, create_interpolations);
 
   // Find cross section corresponding to given sqrt(s)
   double sqrts = sqrt_s();
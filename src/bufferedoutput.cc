@@ -0,0 +1,171 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/bufferedoutput.h"
+
+#include <stdexcept>
+
+#include "smash/action.h"
+#include "smash/clock.h"
+#include "smash/cxx14compat.h"
+#include "smash/particles.h"
+
+namespace smash {
+
+namespace {
+
+/**
+ * \return The output name that reproduces the dilepton, photon and initial
+ * conditions flags of \p output in the OutputInterface constructor.
+ *
+ * \param[in] output Output to be mimicked.
+ */
+std::string flag_name(const OutputInterface &output) {
+  if (output.is_dilepton_output()) {
+    return "Dileptons";
+  } else if (output.is_photon_output()) {
+    return "Photons";
+  } else if (output.is_IC_output()) {
+    return "SMASH_IC";
+  }
+  return "";
+}
+
+/**
+ * \return A deep copy of \p particles, including particle ids.
+ *
+ * \param[in] particles Particles to be copied.
+ */
+std::shared_ptr<Particles> snapshot(const Particles &particles) {
+  auto copy = std::make_shared<Particles>();
+  copy->copy_from(particles);
+  return copy;
+}
+
+/**
+ * An already performed action, reconstructed from what was recorded by
+ * BufferedOutput::at_interaction. It carries everything the outputs read
+ * from an action, but cannot be performed again.
+ */
+class RecordedAction : public Action {
+ public:
+  /**
+   * Construct a recorded action.
+   *
+   * \param[in] in Incoming particles.
+   * \param[in] out Outgoing particles.
+   * \param[in] time Absolute time of execution [fm/c].
+   * \param[in] type Process type.
+   * \param[in] total_weight Total weight of the original action.
+   * \param[in] partial_weight Partial weight of the original action.
+   */
+  RecordedAction(const ParticleList &in, const ParticleList &out, double time,
+                 ProcessType type, double total_weight, double partial_weight)
+      : Action(in, out, time, type),
+        total_weight_(total_weight),
+        partial_weight_(partial_weight) {}
+
+  double get_total_weight() const override { return total_weight_; }
+  double get_partial_weight() const override { return partial_weight_; }
+  void generate_final_state() override {
+    throw std::logic_error("A recorded action cannot be performed.");
+  }
+  void format_debug_output(std::ostream &out) const override {
+    out << "Recorded " << get_type() << ": " << incoming_particles_ << " -> "
+        << outgoing_particles_;
+  }
+
+ private:
+  /// Total weight of the original action
+  const double total_weight_;
+  /// Partial weight of the original action
+  const double partial_weight_;
+};
+
+}  // unnamed namespace
+
+BufferedOutput::BufferedOutput(const OutputInterface &target)
+    : OutputInterface(flag_name(target)) {}
+
+void BufferedOutput::at_eventstart(const Particles &particles,
+                                   const int event_number,
+                                   const EventInfo &info) {
+  auto copy = snapshot(particles);
+  records_.emplace_back([copy, event_number, info](OutputInterface &out) {
+    out.at_eventstart(*copy, event_number, info);
+  });
+}
+
+void BufferedOutput::at_eventend(const Particles &particles,
+                                 const int event_number,
+                                 const EventInfo &info) {
+  auto copy = snapshot(particles);
+  records_.emplace_back([copy, event_number, info](OutputInterface &out) {
+    out.at_eventend(*copy, event_number, info);
+  });
+}
+
+void BufferedOutput::at_interaction(const Action &action,
+                                    const double density) {
+  auto copy = std::make_shared<RecordedAction>(
+      action.incoming_particles(), action.outgoing_particles(),
+      action.time_of_execution(), action.get_type(),
+      action.get_total_weight(), action.get_partial_weight());
+  records_.emplace_back([copy, density](OutputInterface &out) {
+    out.at_interaction(*copy, density);
+  });
+}
+
+void BufferedOutput::at_intermediate_time(const Particles &particles,
+                                          const std::unique_ptr<Clock> &clock,
+                                          const DensityParameters &dens_param,
+                                          const EventInfo &info) {
+  auto copy = snapshot(particles);
+  const double time = clock->current_time();
+  const double dt = clock->timestep_duration();
+  records_.emplace_back(
+      [copy, time, dt, dens_param, info](OutputInterface &out) {
+        const std::unique_ptr<Clock> replayed_clock =
+            make_unique<UniformClock>(time, dt);
+        out.at_intermediate_time(*copy, replayed_clock, dens_param, info);
+      });
+}
+
+void BufferedOutput::thermodynamics_output(
+    const ThermodynamicQuantity tq, const DensityType dt,
+    RectangularLattice<DensityOnLattice> &lattice) {
+  auto copy = std::make_shared<RectangularLattice<DensityOnLattice>>(lattice);
+  records_.emplace_back([tq, dt, copy](OutputInterface &out) {
+    out.thermodynamics_output(tq, dt, *copy);
+  });
+}
+
+void BufferedOutput::thermodynamics_output(
+    const ThermodynamicQuantity tq, const DensityType dt,
+    RectangularLattice<EnergyMomentumTensor> &lattice) {
+  auto copy =
+      std::make_shared<RectangularLattice<EnergyMomentumTensor>>(lattice);
+  records_.emplace_back([tq, dt, copy](OutputInterface &out) {
+    out.thermodynamics_output(tq, dt, *copy);
+  });
+}
+
+void BufferedOutput::thermodynamics_output(const GrandCanThermalizer &) {
+  throw std::logic_error(
+      "Thermalizer output cannot be buffered for multi-threaded runs.");
+}
+
+void BufferedOutput::replay_onto(OutputInterface &target) {
+  for (const Record &record : records_) {
+    record(target);
+  }
+  records_.clear();
+}
+
+}  // namespace smash
@@ -9,6 +9,8 @@
 
 #include "smash/decayaction.h"
 
+#include <cassert>
+
 #include "smash/decaymodes.h"
 #include "smash/logging.h"
 #include "smash/pdgcode.h"
@@ -27,6 +29,12 @@ void DecayAction::add_decay(DecayBranchPtr p) {
   add_process<DecayBranch>(p, decay_channels_, total_width_);
 }
 
+void DecayAction::add_decays(const DecayWidths &widths) {
+  assert(decay_channels_.empty() && mode_widths_.size() == 0);
+  mode_widths_ = widths;
+  total_width_ += widths.total();
+}
+
 void DecayAction::generate_final_state() {
   logg[LDecayModes].debug("Process: Resonance decay. ");
   /* Execute a decay process for the selected particle.
@@ -35,8 +43,17 @@ void DecayAction::generate_final_state() {
    * according to their relative weights. Then decay the particle
    * by calling function sample_2body_phasespace or sample_3body_phasespace.
    */
-  const DecayBranch *proc =
-      choose_channel<DecayBranch>(decay_channels_, total_width_);
+  const DecayBranch *proc = nullptr;
+  if (decay_channels_.empty()) {
+    // Look up the sampled mode in the decay modes of the particle type.
+    const std::size_t i = choose_mode();
+    const ParticleType &type = incoming_particles_[0].type();
+    proc = type.decay_modes().decay_mode_list()[i].get();
+    partial_width_ = mode_widths_[i];
+  } else {
+    proc = choose_channel<DecayBranch>(decay_channels_, total_width_);
+    partial_width_ = proc->weight();
+  }
   outgoing_particles_ = proc->particle_list();
   // set positions of the outgoing particles
   for (auto &p : outgoing_particles_) {
@@ -44,7 +61,6 @@ void DecayAction::generate_final_state() {
   }
   process_type_ = proc->get_type();
   L_ = proc->angular_momentum();
-  partial_width_ = proc->weight();
 
   switch (outgoing_particles_.size()) {
     case 2:
@@ -74,6 +90,27 @@ void DecayAction::generate_final_state() {
   }
 }
 
+std::size_t DecayAction::choose_mode() const {
+  const double random_weight = random::uniform(0., total_width_);
+  double weight_sum = 0.;
+  std::size_t last_open = mode_widths_.size();
+  for (std::size_t i = 0; i < mode_widths_.size(); i++) {
+    if (mode_widths_[i] > 0.) {
+      weight_sum += mode_widths_[i];
+      last_open = i;
+      if (random_weight <= weight_sum) {
+        return i;
+      }
+    }
+  }
+  if (last_open == mode_widths_.size()) {
+    throw InvalidDecay("DecayAction: no open decay mode for " +
+                       incoming_particles_[0].pdgcode().string() + ".");
+  }
+  // Only reached through rounding of the total width.
+  return last_open;
+}
+
 /* This is overridden from the Action class in order to
  * take care of the angular momentum L_. */
 std::pair<double, double> DecayAction::sample_masses(
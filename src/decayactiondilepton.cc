@@ -55,7 +55,7 @@ void DecayActionDilepton::sample_3body_phasespace() {
    * width at a particular dilepton mass. We do an implicit Monte-Carlo
    * integration over the dilepton mass here, and delta_m is simply the
    * integration volume. */
-  branching_ = delta_m * diff_width / decay_channels_[0]->weight();
+  branching_ = delta_m * diff_width / partial_width_;
 
   // perform decay into non-lepton and virtual photon (dilepton)
   const double dil_mom = pCM(cms_energy, dil_mass, mass_nl);
@@ -12,28 +12,30 @@
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decayaction.h"
+#include "smash/decaymodes.h"
 #include "smash/fourvector.h"
 #include "smash/random.h"
 
 namespace smash {
 
 ActionList DecayActionsFinder::find_actions_in_cell(
-    const ParticleList &search_list, double dt, const double,
+    const ParticleListView &search_list, double dt, const double,
     const std::vector<FourVector> &) const {
   ActionList actions;
   /* for short time steps this seems reasonable to expect
    * less than 10 decays in most time steps */
   actions.reserve(10);
+  DecayWidths widths;
 
   for (const auto &p : search_list) {
     if (p.type().is_stable()) {
       continue;  // particle doesn't decay
     }
 
-    DecayBranchList processes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic);
+    p.type().get_partial_widths(p.momentum(), p.position().threevec(),
+                                WhichDecaymodes::Hadronic, &widths);
     // total decay width (mass-dependent)
-    const double width = total_weight<DecayBranch>(processes);
+    const double width = widths.total();
 
     // check if there are any (hadronic) decays
     if (!(width > 0.0)) {
@@ -61,7 +63,7 @@ ActionList DecayActionsFinder::find_actions_in_cell(
       /* => decay_time ∈ [0, dt[
        * => the particle decays in this timestep. */
       auto act = make_unique<DecayAction>(p, decay_time);
-      act->add_decays(std::move(processes));
+      act->add_decays(widths);
       actions.emplace_back(std::move(act));
     }
   }
@@ -71,14 +73,16 @@ ActionList DecayActionsFinder::find_actions_in_cell(
 ActionList DecayActionsFinder::find_final_actions(const Particles &search_list,
                                                   bool /*only_res*/) const {
   ActionList actions;
+  DecayWidths widths;
 
   for (const auto &p : search_list) {
     if (p.type().is_stable()) {
       continue;  // particle doesn't decay
     }
     auto act = make_unique<DecayAction>(p, 0.);
-    act->add_decays(p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::All));
+    p.type().get_partial_widths(p.momentum(), p.position().threevec(),
+                                WhichDecaymodes::All, &widths);
+    act->add_decays(widths);
     actions.emplace_back(std::move(act));
   }
   return actions;
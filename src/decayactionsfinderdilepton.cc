@@ -9,6 +9,8 @@
 
 #include "smash/decayactionsfinderdilepton.h"
 
+#include <algorithm>
+
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decayactiondilepton.h"
@@ -16,45 +18,132 @@
 
 namespace smash {
 
+namespace {
+/**
+ * Shine the dilepton decays of one particle, i.e. write every open dilepton
+ * mode to the output as a decay with the given weight per width.
+ *
+ * \param[in] p Particle that shines.
+ * \param[in] widths Partial widths of all its decay modes.
+ * \param[in] weight_per_width Factor converting a partial width to the
+ *            shining weight.
+ * \param[in] output The dilepton output.
+ */
+void shine_modes(const ParticleData &p, const DecayWidths &widths,
+                 double weight_per_width, OutputInterface *output) {
+  const ParticleType &t = p.type();
+  const auto &modes = t.decay_modes().decay_mode_list();
+  DecayWidths single;
+  for (std::size_t i = 0; i < widths.size(); i++) {
+    if (!t.wanted_decaymode(modes[i]->type(), WhichDecaymodes::Dileptons)) {
+      continue;
+    }
+    const double shining_weight = weight_per_width * widths[i];
+
+    if (shining_weight > 0.0) {  // decays that can happen
+      DecayActionDilepton act(p, 0., shining_weight);
+      single.reset(widths.size());
+      single.set(i, widths[i]);
+      act.add_decays(single);
+      act.generate_final_state();
+      output->at_interaction(act, 0.0);
+    }
+  }
+}
+
+/**
+ * Shine the dilepton decays of one particle during a time interval, unless
+ * it is stable, unformed or can only decay into dileptons. Those are only
+ * considered in DecayActionsFinderDilepton::shine_final.
+ *
+ * \param[in] p Particle that shines.
+ * \param[in] dt Length of the time interval in the computational frame [fm].
+ * \param[in] output The dilepton output.
+ * \param[out] widths Buffer for the partial widths of \p p.
+ */
+void shine_particle(const ParticleData &p, double dt, OutputInterface *output,
+                    DecayWidths *widths) {
+  const ParticleType &t = p.type();
+  t.get_partial_widths(p.momentum(), p.position().threevec(),
+                       WhichDecaymodes::All, widths);
+  const std::size_t n_all_modes = widths->number_of_open_modes();
+  if (n_all_modes == 0) {
+    return;
+  }
+
+  const auto &modes = t.decay_modes().decay_mode_list();
+  std::size_t n_dil_modes = 0;
+  for (std::size_t i = 0; i < widths->size(); i++) {
+    if ((*widths)[i] > 0. &&
+        t.wanted_decaymode(modes[i]->type(), WhichDecaymodes::Dileptons)) {
+      n_dil_modes++;
+    }
+  }
+
+  /* If particle can only decay into dileptons or is stable, use shining only
+   * in find_final_actions and ignore them here, also unformed
+   * resonances cannot decay */
+  if (n_dil_modes == n_all_modes || t.is_stable() ||
+      (p.formation_time() > p.position().x0())) {
+    return;
+  }
+
+  // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
+  shine_modes(p, *widths, dt * p.inverse_gamma() / hbarc, output);
+}
+
+/**
+ * Shine all particles of \p particles over the time they existed since
+ * \p since, see DecayActionsFinderDilepton::shine_accumulated.
+ *
+ * \tparam Container Particles or ParticleList
+ * \param[in] particles Particles to be shone.
+ * \param[in] output The dilepton output.
+ * \param[in] since Time up to which the particles were already shone [fm].
+ */
+template <typename Container>
+void shine_since(const Container &particles, OutputInterface *output,
+                 double since) {
+  DecayWidths widths;
+  for (const ParticleData &p : particles) {
+    double start = std::max(since, p.formation_time());
+    // particles from the initial conditions have not interacted yet
+    if (p.get_history().collisions_per_particle > 0) {
+      start = std::max(start, p.get_history().time_last_collision);
+    }
+    const double dt = p.position().x0() - start;
+    if (dt > 0.) {
+      shine_particle(p, dt, output, &widths);
+    }
+  }
+}
+}  // unnamed namespace
+
 void DecayActionsFinderDilepton::shine(const Particles &search_list,
                                        OutputInterface *output,
                                        double dt) const {
   if (!output->is_dilepton_output()) {
     return;
   }
+  DecayWidths widths;
   for (const auto &p : search_list) {
-    const auto n_all_modes =
-        p.type()
-            .get_partial_widths(p.momentum(), p.position().threevec(),
-                                WhichDecaymodes::All)
-            .size();
-    if (n_all_modes == 0) {
-      continue;
-    }
-
-    const double inv_gamma = p.inverse_gamma();
-    DecayBranchList dil_modes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
-
-    /* If particle can only decay into dileptons or is stable, use shining only
-     * in find_final_actions and ignore them here, also unformed
-     * resonances cannot decay */
-    if (dil_modes.size() == n_all_modes || p.type().is_stable() ||
-        (p.formation_time() > p.position().x0())) {
-      continue;
-    }
+    shine_particle(p, dt, output, &widths);
+  }
+}
 
-    for (DecayBranchPtr &mode : dil_modes) {
-      // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
-      const double shining_weight = dt * inv_gamma * mode->weight() / hbarc;
+void DecayActionsFinderDilepton::shine_accumulated(const Particles &search_list,
+                                                   OutputInterface *output,
+                                                   double since) const {
+  if (output->is_dilepton_output()) {
+    shine_since(search_list, output, since);
+  }
+}
 
-      if (shining_weight > 0.0) {  // decays that can happen
-        DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
-        act.generate_final_state();
-        output->at_interaction(act, 0.0);
-      }
-    }
+void DecayActionsFinderDilepton::shine_accumulated(
+    const ParticleList &search_list, OutputInterface *output,
+    double since) const {
+  if (output->is_dilepton_output()) {
+    shine_since(search_list, output, since);
   }
 }
 
@@ -64,6 +153,7 @@ void DecayActionsFinderDilepton::shine_final(const Particles &search_list,
   if (!output->is_dilepton_output()) {
     return;
   }
+  DecayWidths widths;
   for (const auto &p : search_list) {
     const ParticleType &t = p.type();
     if (t.decay_modes().decay_mode_list().empty() ||
@@ -71,23 +161,10 @@ void DecayActionsFinderDilepton::shine_final(const Particles &search_list,
       continue;
     }
 
-    DecayBranchList dil_modes = t.get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
-
     // total decay width, also hadronic decays
-    const double width_tot = total_weight<DecayBranch>(t.get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::All));
-
-    for (DecayBranchPtr &mode : dil_modes) {
-      const double shining_weight = mode->weight() / width_tot;
-
-      if (shining_weight > 0.0) {  // decays that can happen
-        DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
-        act.generate_final_state();
-        output->at_interaction(act, 0.0);
-      }
-    }
+    t.get_partial_widths(p.momentum(), p.position().threevec(),
+                         WhichDecaymodes::All, &widths);
+    shine_modes(p, widths, 1. / widths.total(), output);
   }
 }
 
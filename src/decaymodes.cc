@@ -38,6 +38,10 @@ void DecayModes::add_mode(ParticleTypePtr mother, double ratio, int L,
     }
   }
   // Add new mode.
+  if (decay_modes_.size() == DecayWidths::capacity) {
+    throw LoadFailure("More than " + std::to_string(DecayWidths::capacity) +
+                      " decay modes for " + mother->name() + ".");
+  }
   decay_modes_.push_back(make_unique<DecayBranch>(*type, ratio));
 }
 
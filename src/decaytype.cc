@@ -141,25 +141,28 @@ double TwoBodyDecaySemistable::get_Lambda() {
 
 /// Number of tabulation points.
 constexpr size_t num_tab_pts = 200;
-static /*thread_local (see #3075)*/ Integrator integrate;
+static thread_local Integrator integrate;
 
-double TwoBodyDecaySemistable::rho(double mass) const {
-  if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
-    const ParticleTypePtr res = particle_types_[1];
-    const double tabulation_interval = std::max(2., 10. * res->width_at_pole());
-    const double m_stable = particle_types_[0]->mass();
-    const double mres_min = res->min_mass_kinematic();
-
-    tabulation_ = make_unique<Tabulation>(
-        threshold(), tabulation_interval, num_tab_pts, [&](double sqrts) {
-          const double mres_max = sqrts - m_stable;
-          return integrate(mres_min, mres_max, [&](double m) {
-            return integrand_rho_Manley_1res(sqrts, m, m_stable, res, L_);
-          });
-        });
+void TwoBodyDecaySemistable::tabulate() const {
+  if (tabulation_ != nullptr) {
+    return;
   }
+  const ParticleTypePtr res = particle_types_[1];
+  const double tabulation_interval = std::max(2., 10. * res->width_at_pole());
+  const double m_stable = particle_types_[0]->mass();
+  const double mres_min = res->min_mass_kinematic();
+
+  tabulation_ = make_unique<Tabulation>(
+      threshold(), tabulation_interval, num_tab_pts, [&](double sqrts) {
+        const double mres_max = sqrts - m_stable;
+        return integrate(mres_min, mres_max, [&](double m) {
+          return integrand_rho_Manley_1res(sqrts, m, m_stable, res, L_);
+        });
+      });
+}
+
+double TwoBodyDecaySemistable::rho(double mass) const {
+  tabulate();
   return tabulation_->get_value_linear(mass);
 }
 
@@ -195,33 +198,36 @@ double TwoBodyDecayUnstable::get_Lambda() {
   return 0.6;
 }
 
-static /*thread_local*/ Integrator2d integrate2d(1E7);
+static thread_local Integrator2d integrate2d(1E7);
 
-double TwoBodyDecayUnstable::rho(double mass) const {
-  if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
-    const ParticleTypePtr r1 = particle_types_[0];
-    const ParticleTypePtr r2 = particle_types_[1];
-    const double m1_min = r1->min_mass_kinematic();
-    const double m2_min = r2->min_mass_kinematic();
-    const double sum_gamma = r1->width_at_pole() + r2->width_at_pole();
-    const double tab_interval = std::max(2., 10. * sum_gamma);
-
-    tabulation_ = make_unique<Tabulation>(
-        m1_min + m2_min, tab_interval, num_tab_pts, [&](double sqrts) {
-          const double m1_max = sqrts - m2_min;
-          const double m2_max = sqrts - m1_min;
-
-          const double result = integrate2d(m1_min, m1_max, m2_min, m2_max,
-                                            [&](double m1, double m2) {
-                                              return integrand_rho_Manley_2res(
-                                                  sqrts, m1, m2, r1, r2, L_);
-                                            })
-                                    .value();
-          return result;
-        });
+void TwoBodyDecayUnstable::tabulate() const {
+  if (tabulation_ != nullptr) {
+    return;
   }
+  const ParticleTypePtr r1 = particle_types_[0];
+  const ParticleTypePtr r2 = particle_types_[1];
+  const double m1_min = r1->min_mass_kinematic();
+  const double m2_min = r2->min_mass_kinematic();
+  const double sum_gamma = r1->width_at_pole() + r2->width_at_pole();
+  const double tab_interval = std::max(2., 10. * sum_gamma);
+
+  tabulation_ = make_unique<Tabulation>(
+      m1_min + m2_min, tab_interval, num_tab_pts, [&](double sqrts) {
+        const double m1_max = sqrts - m2_min;
+        const double m2_max = sqrts - m1_min;
+
+        const double result = integrate2d(m1_min, m1_max, m2_min, m2_max,
+                                          [&](double m1, double m2) {
+                                            return integrand_rho_Manley_2res(
+                                                sqrts, m1, m2, r1, r2, L_);
+                                          })
+                                  .value();
+        return result;
+      });
+}
+
+double TwoBodyDecayUnstable::rho(double mass) const {
+  tabulate();
   return tabulation_->get_value_linear(mass);
 }
 
@@ -422,44 +428,47 @@ double ThreeBodyDecayDilepton::diff_width(double m_par, double m_l,
   }
 }
 
-double ThreeBodyDecayDilepton::width(double, double G0, double m) const {
-  if (mother_->is_stable()) {
-    return G0;
+void ThreeBodyDecayDilepton::tabulate() const {
+  if (tabulation_ || mother_->is_stable()) {
+    return;
   }
-
-  if (!tabulation_) {
-    int non_lepton_position = -1;
-    for (int i = 0; i < 3; ++i) {
-      if (!particle_types_[i]->is_lepton()) {
-        non_lepton_position = i;
-        break;
-      }
+  int non_lepton_position = -1;
+  for (int i = 0; i < 3; ++i) {
+    if (!particle_types_[i]->is_lepton()) {
+      non_lepton_position = i;
+      break;
     }
-    // lepton mass
-    const double m_l = particle_types_[(non_lepton_position + 1) % 3]->mass();
-    // mass of non-leptonic particle in final state
-    const double m_other = particle_types_[non_lepton_position]->mass();
-
-    // integrate differential width to obtain partial width
-    double M0 = mother_->mass();
-    double G0tot = mother_->width_at_pole();
-    tabulation_ = make_unique<Tabulation>(
-        m_other + 2 * m_l, M0 + 10 * G0tot, num_tab_pts, [&](double m_parent) {
-          const double bottom = 2 * m_l;
-          const double top = m_parent - m_other;
-          if (top < bottom) {  // numerical problems at lower bound
-            return 0.;
-          }
-          return integrate(bottom, top,
-                           [&](double m_dil) {
-                             return diff_width(
-                                 m_parent, m_l, m_dil, m_other,
-                                 particle_types_[non_lepton_position], mother_);
-                           })
-              .value();
-        });
   }
+  // lepton mass
+  const double m_l = particle_types_[(non_lepton_position + 1) % 3]->mass();
+  // mass of non-leptonic particle in final state
+  const double m_other = particle_types_[non_lepton_position]->mass();
+
+  // integrate differential width to obtain partial width
+  double M0 = mother_->mass();
+  double G0tot = mother_->width_at_pole();
+  tabulation_ = make_unique<Tabulation>(
+      m_other + 2 * m_l, M0 + 10 * G0tot, num_tab_pts, [&](double m_parent) {
+        const double bottom = 2 * m_l;
+        const double top = m_parent - m_other;
+        if (top < bottom) {  // numerical problems at lower bound
+          return 0.;
+        }
+        return integrate(bottom, top,
+                         [&](double m_dil) {
+                           return diff_width(
+                               m_parent, m_l, m_dil, m_other,
+                               particle_types_[non_lepton_position], mother_);
+                         })
+            .value();
+      });
+}
 
+double ThreeBodyDecayDilepton::width(double, double G0, double m) const {
+  if (mother_->is_stable()) {
+    return G0;
+  }
+  tabulate();
   return tabulation_->get_value_linear(m, Extrapolation::Const);
 }
 
@@ -8,6 +8,12 @@
  */
 
 #include "smash/density.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
 #include "smash/constants.h"
 #include "smash/logging.h"
 
@@ -34,6 +40,24 @@ double density_factor(const ParticleType &type, DensityType dens_type) {
   }
 }
 
+void DensityParameters::tabulate_kernel(double tolerance) {
+  if (tolerance < 0.) {
+    throw std::invalid_argument(
+        "The tolerance of the tabulated smearing kernel has to be positive.");
+  }
+  if (tolerance == 0.) {
+    kernel_ = nullptr;
+    return;
+  }
+  /* The error of the linear interpolation of exp(-x) is bounded by
+   * dx^2 / 8 * max|d^2/dx^2 exp(-x)| = dx^2 / 8. */
+  const double dx = std::sqrt(8. * tolerance);
+  const double x_max = r_cut_sqr_ * two_sig_sqr_inv_;
+  const size_t num = std::max<size_t>(2, std::ceil(x_max / dx));
+  kernel_ = std::make_shared<const Tabulation>(
+      0., x_max, num, [](double x) { return std::exp(-x); });
+}
+
 std::pair<double, ThreeVector> unnormalized_smearing_factor(
     const ThreeVector &r, const FourVector &p, const double m_inv,
     const DensityParameters &dens_par, const bool compute_gradient) {
@@ -51,7 +75,8 @@ std::pair<double, ThreeVector> unnormalized_smearing_factor(
   if (r_rest_sqr > dens_par.r_cut_sqr()) {
     return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
   }
-  const double sf = std::exp(-r_rest_sqr * dens_par.two_sig_sqr_inv()) * u.x0();
+  const double sf = dens_par.kernel(r_rest_sqr * dens_par.two_sig_sqr_inv()) *
+                    u.x0();
   const ThreeVector sf_grad = compute_gradient
                                   ? sf * (r + u.threevec() * u_r_scalar) *
                                         dens_par.two_sig_sqr_inv() * 2.0
@@ -159,6 +184,292 @@ current_eckart(const ThreeVector &r, const Particles &plist,
                              smearing);
 }
 
+namespace {
+
+/**
+ * Convolve a field on a lattice with a kernel along one axis, i.e.
+ * \f$ out(n) = \sum_d in(n - d) K(d) \f$, where the offset d runs along
+ * the axis. Nodes without content are skipped, which makes this cheap for
+ * sparse fields.
+ *
+ * \param[in] in Field on the lattice, indexed like RectangularLattice.
+ * \param[in] n Number of cells in x, y, z directions.
+ * \param[in] axis Axis along which is convolved.
+ * \param[in] kernel Kernel values K(d) for the offsets d = -h, ..., h.
+ * \param[in] periodic Whether the lattice is periodic.
+ * \param[out] out The convolved field. Its memory is reused; it must not be
+ *             \p in.
+ */
+void convolve_along(const std::vector<double> &in,
+                    const std::array<int, 3> &n, int axis,
+                    const std::vector<double> &kernel, bool periodic,
+                    std::vector<double> *out) {
+  const int h = kernel.size() / 2;
+  const int stride = axis == 0 ? 1 : axis == 1 ? n[0] : n[0] * n[1];
+  const int length = n[axis];
+  out->assign(in.size(), 0.);
+  for (size_t i = 0; i < in.size(); i++) {
+    if (in[i] == 0.) {
+      continue;
+    }
+    const int c = (i / stride) % length;
+    for (int d = -h; d <= h; d++) {
+      int target = c + d;
+      if (periodic) {
+        target = ((target % length) + length) % length;
+      } else if (target < 0 || target >= length) {
+        continue;
+      }
+      (*out)[i + (target - c) * stride] += in[i] * kernel[d + h];
+    }
+  }
+}
+
+/**
+ * \return the fields deposited by update_lattices_by_convolution on the
+ * calling thread, per lattice and field. They are kept from one call to the
+ * next, so that their memory is only allocated once.
+ */
+std::vector<std::vector<std::vector<double>>> &convolution_fields() {
+  thread_local std::vector<std::vector<std::vector<double>>> fields;
+  return fields;
+}
+
+}  // unnamed namespace
+
+void update_lattices_by_convolution(
+    const std::vector<std::pair<DensityLattice *, DensityType>> &lattices,
+    const LatticeUpdate update, const DensityParameters &par,
+    const Particles &particles, const bool compute_gradient,
+    ThreadPool *pool) {
+  // Only keep the lattices that exist and need an update
+  std::vector<std::pair<DensityLattice *, DensityType>> targets;
+  for (const auto &lattice : lattices) {
+    if (lattice.first == nullptr || lattice.first->when_update() != update) {
+      continue;
+    }
+    if (!targets.empty() &&
+        !lattice.first->identical_to_lattice(targets.front().first)) {
+      throw std::invalid_argument(
+          "Lattices updated in one pass need to have the same structure.");
+    }
+    targets.push_back(lattice);
+  }
+  if (targets.empty()) {
+    return;
+  }
+  const DensityLattice &lat = *targets.front().first;
+  const std::array<int, 3> &n = lat.dimensions();
+  const std::array<double, 3> &a = lat.cell_sizes();
+  const std::array<double, 3> &origin = lat.origin();
+  const bool periodic = lat.periodic();
+  const size_t n_nodes = lat.size();
+
+  /* The fields deposited for every lattice: the four-velocities of the
+   * positively (0-3) and negatively (4-7) contributing particles; for the
+   * gradients the net four-velocity (8-11) and its product with the
+   * velocity components v_k (12 + 4 (k - 1) + mu). A field is only cleared
+   * once something is deposited on it. */
+  const int n_fields = compute_gradient ? 24 : 8;
+  std::vector<std::vector<std::vector<double>>> &fields = convolution_fields();
+  fields.resize(targets.size());
+  for (auto &lattice_fields : fields) {
+    lattice_fields.resize(n_fields);
+  }
+  std::vector<std::vector<bool>> deposited(targets.size(),
+                                           std::vector<bool>(n_fields));
+  const auto add = [&](size_t l, int field, size_t index, double value) {
+    std::vector<double> &f = fields[l][field];
+    if (!deposited[l][field]) {
+      f.assign(n_nodes, 0.);
+      deposited[l][field] = true;
+    }
+    f[index] += value;
+  };
+
+  // Cloud-in-cell assignment to the 8 nodes around every particle
+  std::vector<double> dens_factors(targets.size());
+  for (const auto &part : particles) {
+    bool contributes = false;
+    for (size_t l = 0; l < targets.size(); l++) {
+      dens_factors[l] = density_factor(part.type(), targets[l].second);
+      contributes = contributes || std::abs(dens_factors[l]) >= really_small;
+    }
+    if (!contributes) {
+      continue;
+    }
+    const ThreeVector pos = part.position().threevec();
+    const ThreeVector v = part.velocity();
+    const FourVector u(1., v);
+    std::array<int, 3> lower;
+    std::array<double, 3> w_upper;
+    for (int k = 0; k < 3; k++) {
+      const double t = (pos[k] - origin[k]) / a[k] - 0.5;
+      lower[k] = std::floor(t);
+      w_upper[k] = t - lower[k];
+    }
+    for (int corner = 0; corner < 8; corner++) {
+      double weight = 1. / par.ntest();
+      std::array<int, 3> c;
+      bool inside = true;
+      for (int k = 0; k < 3; k++) {
+        const bool upper = corner & (1 << k);
+        c[k] = lower[k] + upper;
+        weight *= upper ? w_upper[k] : 1. - w_upper[k];
+        if (periodic) {
+          c[k] = ((c[k] % n[k]) + n[k]) % n[k];
+        } else if (c[k] < 0 || c[k] >= n[k]) {
+          inside = false;
+        }
+      }
+      if (!inside || weight == 0.) {
+        continue;
+      }
+      const size_t index = c[0] + n[0] * (c[1] + n[1] * c[2]);
+      for (size_t l = 0; l < targets.size(); l++) {
+        if (std::abs(dens_factors[l]) < really_small) {
+          continue;
+        }
+        const double q = dens_factors[l] * weight;
+        const int offset = q > 0. ? 0 : 4;
+        for (int mu = 0; mu < 4; mu++) {
+          add(l, offset + mu, index, q * u[mu]);
+        }
+        if (compute_gradient) {
+          for (int mu = 0; mu < 4; mu++) {
+            add(l, 8 + mu, index, q * u[mu]);
+            for (int k = 1; k <= 3; k++) {
+              add(l, 12 + 4 * (k - 1) + mu, index, q * u[mu] * v[k - 1]);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /* The Gaussian and its derivative along every axis, normalized on the
+   * lattice. The cloud-in-cell assignment broadens the distribution by a
+   * variance of a^2 / 6, which is taken off the width. */
+  const double sigma_sqr = 0.5 / par.two_sig_sqr_inv();
+  std::array<std::vector<double>, 3> gauss, gauss_derivative;
+  for (int k = 0; k < 3; k++) {
+    const double width_sqr =
+        std::max(sigma_sqr - a[k] * a[k] / 6., 0.5 * sigma_sqr);
+    const int h = par.r_cut() / a[k];
+    double norm = 0., first_moment = 0.;
+    for (int j = -h; j <= h; j++) {
+      const double x = j * a[k];
+      gauss[k].push_back(std::exp(-0.5 * x * x / width_sqr));
+      gauss_derivative[k].push_back(-x / width_sqr * gauss[k].back());
+      norm += gauss[k].back() * a[k];
+      first_moment += gauss_derivative[k].back() * x * a[k];
+    }
+    // the derivative of a linear function is reproduced exactly
+    for (int j = 0; j <= 2 * h; j++) {
+      gauss[k][j] /= norm;
+      gauss_derivative[k][j] /= -first_moment;
+    }
+  }
+
+  /* Convolves the field \p in along all axes, with the derivative of the
+   * Gaussian along the axis \p derivative (-1 for none), into \p out, which
+   * may be \p in. The scratch space is kept by every thread. */
+  const auto convolve = [&](const std::vector<double> &in, int derivative,
+                            std::vector<double> *out) {
+    thread_local std::vector<double> scratch;
+    const auto &kernel = [&](int k) -> const std::vector<double> & {
+      return k == derivative ? gauss_derivative[k] : gauss[k];
+    };
+    convolve_along(in, n, 0, kernel(0), periodic, &scratch);
+    convolve_along(scratch, n, 1, kernel(1), periodic, out);
+    convolve_along(*out, n, 2, kernel(2), periodic, &scratch);
+    out->swap(scratch);
+  };
+
+  /* The fields are convolved in place and independently of each other,
+   * except that the gradient fields of one component mu are handled
+   * together. They are distributed over the threads. Afterwards, field 12 +
+   * mu holds the divergence of the current term, and fields 16 + mu, 20 + mu
+   * and 8 + mu hold the derivatives of the net four-velocity along x, y and
+   * z. */
+  struct Task {
+    size_t lattice;
+    // the field 0-7, or 8 + mu for the gradient fields of mu
+    int field;
+  };
+  std::vector<Task> tasks;
+  for (size_t l = 0; l < targets.size(); l++) {
+    for (int field = 0; field < (compute_gradient ? 12 : 8); field++) {
+      if (deposited[l][field]) {
+        tasks.push_back({l, field});
+      }
+    }
+  }
+  std::atomic<size_t> next_task{0};
+  auto work = [&]() {
+    thread_local std::vector<double> term;
+    for (size_t i = next_task++; i < tasks.size(); i = next_task++) {
+      std::vector<std::vector<double>> &f = fields[tasks[i].lattice];
+      const int field = tasks[i].field;
+      if (field < 8) {
+        convolve(f[field], -1, &f[field]);
+        continue;
+      }
+      const int mu = field - 8;
+      std::vector<double> &divergence = f[12 + mu];
+      convolve(divergence, 0, &divergence);
+      for (int k = 1; k < 3; k++) {
+        convolve(f[12 + 4 * k + mu], k, &term);
+        for (size_t node = 0; node < n_nodes; node++) {
+          divergence[node] += term[node];
+        }
+      }
+      convolve(f[field], 0, &f[16 + mu]);
+      convolve(f[field], 1, &f[20 + mu]);
+      convolve(f[field], 2, &f[field]);
+    }
+  };
+  if (pool != nullptr) {
+    pool->run(work);
+  } else {
+    work();
+  }
+
+  // Collect the results on the nodes, leaving the empty ones untouched
+  for (size_t l = 0; l < targets.size(); l++) {
+    DensityLattice &target = *targets[l].first;
+    target.reset();
+    const std::vector<std::vector<double>> &f = fields[l];
+    const auto value = [&](int field, size_t node) {
+      return deposited[l][field] ? f[field][node] : 0.;
+    };
+    // the field holding the derivative along axis k, see above
+    const int derivative_field[3] = {16, 20, 8};
+    for (size_t i = 0; i < n_nodes; i++) {
+      FourVector jmu_pos, jmu_neg;
+      std::array<FourVector, 4> djmu_dx;
+      bool empty = true;
+      for (int mu = 0; mu < 4; mu++) {
+        jmu_pos[mu] = value(mu, i);
+        jmu_neg[mu] = value(4 + mu, i);
+        empty = empty && jmu_pos[mu] == 0. && jmu_neg[mu] == 0.;
+        if (!compute_gradient || !deposited[l][8 + mu]) {
+          continue;
+        }
+        djmu_dx[0][mu] = -f[12 + mu][i];
+        for (int k = 0; k < 3; k++) {
+          djmu_dx[k + 1][mu] = f[derivative_field[k] + mu][i];
+        }
+        empty = empty && djmu_dx[0][mu] == 0. && djmu_dx[1][mu] == 0. &&
+                djmu_dx[2][mu] == 0. && djmu_dx[3][mu] == 0.;
+      }
+      if (!empty) {
+        target[i] = DensityOnLattice(jmu_pos, jmu_neg, djmu_dx);
+      }
+    }
+  }
+}
+
 std::ostream &operator<<(std::ostream &os, DensityType dens_type) {
   switch (dens_type) {
     case DensityType::Hadron:
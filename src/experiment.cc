@@ -77,7 +77,9 @@ ExperimentPtr ExperimentBase::create(Configuration config,
  * around 0.1 fm/c. However, if potentials are off, it can be arbitrarily
  * large. In this case it only influences the runtime, but not physics.
  * If Time_Step_Mode = None is chosen, then the user-provided value of
- * Delta_Time is ignored and Delta_Time is set to the End_Time.
+ * Delta_Time is ignored and Delta_Time is set to the End_Time. With
+ * Time_Step_Mode = Adaptive, Delta_Time is the duration of the first time step
+ * of every event.
  *
  * \key Testparticles (int, optional, default = 1): \n
  * How many test particles per real particle should be simulated.
@@ -88,6 +90,14 @@ ExperimentPtr ExperimentBase::create(Configuration config,
  * \key Gauss_Cutoff_In_Sigma (double, optional, default = 4.0): \n
  * Distance in sigma at which gaussian is considered 0.
  *
+ * \key Gauss_Kernel_Tolerance (double, optional, default = 0.0): \n
+ * If positive, the gaussian used for smearing densities is tabulated and
+ * interpolated, which saves an exponential for every particle and lattice
+ * node. The value is the largest allowed deviation from the exact gaussian,
+ * whose maximum is 1. Values around 1.e-6 change the densities by much less
+ * than their statistical fluctuations. For 0, the gaussian is evaluated
+ * exactly.
+ *
  * \page input_output_options_ Output Configuration
  *
  * Description of options
@@ -487,6 +497,16 @@ ExperimentParameters create_experiment_parameters(Configuration config) {
       config_coll.take({"Additional_Elastic_Cross_Section"}, 0.0)};
 }
 
+std::unique_ptr<Configuration> create_worker_configuration(
+    Configuration config) {
+  if (config.read({"General", "Threads"}, 1) <= 1) {
+    return nullptr;
+  }
+  auto worker_config = make_unique<Configuration>(config.clone());
+  worker_config->take({"General", "Threads"});
+  return worker_config;
+}
+
 std::string format_measurements(const Particles &particles,
                                 uint64_t scatterings_this_interval,
                                 const QuantumNumbers &conserved_initial,
@@ -9,12 +9,17 @@
 
 #include "smash/grid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <stdexcept>
 
 #include "smash/algorithms.h"
 #include "smash/fourvector.h"
 #include "smash/logging.h"
 #include "smash/particledata.h"
+#include "smash/threadpool.h"
 #include "smash/threevector.h"
 
 namespace std {
@@ -101,18 +106,54 @@ template <GridOptions O>
 Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
                   &min_and_length,
               const Particles &particles, double max_interaction_length,
-              double timestep_duration, CellSizeStrategy strategy)
-    : length_(min_and_length.second) {
-  const auto min_position = min_and_length.first;
-  const SizeType particle_count = particles.size();
+              double timestep_duration, CellSizeStrategy strategy) {
+  update(min_and_length, particles, max_interaction_length, timestep_duration,
+         strategy);
+}
+
+template <GridOptions O>
+bool Grid<O>::update(
+    const std::pair<std::array<double, 3>, std::array<double, 3>>
+        &min_and_length,
+    const Particles &particles, double max_interaction_length,
+    double timestep_duration, CellSizeStrategy strategy) {
+  const CellFilling previous_filling = filling_;
+  const std::array<int, 3> previous_number_of_cells = number_of_cells_;
+  const std::array<double, 3> previous_min_position = min_position_;
+  const std::array<double, 3> previous_index_factor = index_factor_;
+
+  determine_layout(min_and_length, particles.size(), max_interaction_length,
+                   strategy);
+
+  const bool keep_cells =
+      filling_ == CellFilling::Cells && previous_filling == filling_ &&
+      previous_number_of_cells == number_of_cells_ &&
+      previous_min_position == min_position_ &&
+      previous_index_factor == index_factor_;
+  if (keep_cells) {
+    move_particles(particles, timestep_duration);
+  } else {
+    fill_cells(particles, timestep_duration);
+  }
+  particles_ = &particles;
+  return !keep_cells;
+}
+
+template <GridOptions O>
+void Grid<O>::determine_layout(
+    const std::pair<std::array<double, 3>, std::array<double, 3>>
+        &min_and_length,
+    const SizeType particle_count, double max_interaction_length,
+    CellSizeStrategy strategy) {
+  min_position_ = min_and_length.first;
+  length_ = min_and_length.second;
 
   // very simple setup for non-periodic boundaries and largest cellsize strategy
   if (O == GridOptions::Normal && strategy == CellSizeStrategy::Largest) {
+    filling_ = CellFilling::AllInOne;
     number_of_cells_ = {1, 1, 1};
+    index_factor_ = {0., 0., 0.};
     cell_volume_ = length_[0] * length_[1] * length_[2];
-    cells_.clear();
-    cells_.reserve(1);
-    cells_.emplace_back(particles.copy_to_vector());
     return;
   }
 
@@ -146,9 +187,9 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
 
   // This normally equals 1/max_interaction_length, but if the number of cells
   // is reduced (because of low density) then this value is smaller.
-  std::array<double, 3> index_factor = {1. / max_interaction_length,
-                                        1. / max_interaction_length,
-                                        1. / max_interaction_length};
+  std::array<double, 3> &index_factor = index_factor_;
+  index_factor = {1. / max_interaction_length, 1. / max_interaction_length,
+                  1. / max_interaction_length};
   for (std::size_t i = 0; i < number_of_cells_.size(); ++i) {
     number_of_cells_[i] =
         (strategy == CellSizeStrategy::Largest)
@@ -215,60 +256,216 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
         "There would only be ", number_of_cells_,
         " cells. Therefore the Grid falls back to a single cell / "
         "particle list.");
+    filling_ = CellFilling::InteractingInOne;
     number_of_cells_ = {1, 1, 1};
     cell_volume_ = length_[0] * length_[1] * length_[2];
-    cells_.resize(1);
-    cells_.front().reserve(particles.size());
-    std::copy_if(particles.begin(), particles.end(),
-                 std::back_inserter(cells_.front()),
-                 [&](const ParticleData &p) {
-                   return p.xsec_scaling_factor(timestep_duration) > 0.0;
-                 });  // filter out the particles that can not interact
   } else {
-    // construct a normal grid
-    logg[LGrid].debug("min: ", min_position, "\nlength: ", length_,
+    filling_ = CellFilling::Cells;
+    logg[LGrid].debug("min: ", min_position_, "\nlength: ", length_,
                       "\ncell_volume: ", cell_volume_,
                       "\ncells: ", number_of_cells_,
-                      "\nindex_factor: ", index_factor);
-
-    // After the grid parameters are determined, we can start placing the
-    // particles in cells.
-    cells_.resize(number_of_cells_[0] * number_of_cells_[1] *
-                  number_of_cells_[2]);
-
-    // Returns the one-dimensional cell-index from the position vector inside
-    // the grid.
-    // This simply calculates the distance to min_position and multiplies it
-    // with index_factor to determine the 3 x,y,z indexes to pass to make_index.
-    auto &&cell_index_for = [&](const ParticleData &p) {
-      return make_index(
-          std::floor((p.position()[1] - min_position[0]) * index_factor[0]),
-          std::floor((p.position()[2] - min_position[1]) * index_factor[1]),
-          std::floor((p.position()[3] - min_position[2]) * index_factor[2]));
-    };
-
-    for (const auto &p : particles) {
-      if (p.xsec_scaling_factor(timestep_duration) > 0.0) {
-        const auto idx = cell_index_for(p);
-#ifndef NDEBUG
-        if (idx >= SizeType(cells_.size())) {
-          logg[LGrid].fatal(
-              source_location,
-              "\nan out-of-bounds access would be necessary for the "
-              "particle ",
-              p, "\nfor a grid with the following parameters:\nmin: ",
-              min_position, "\nlength: ", length_,
-              "\ncells: ", number_of_cells_, "\nindex_factor: ", index_factor,
-              "\ncells_.size: ", cells_.size(), "\nrequested index: ", idx);
-          throw std::runtime_error("out-of-bounds grid access on construction");
+                      "\nindex_factor: ", index_factor_);
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::fill_cells(const Particles &particles,
+                         double timestep_duration) {
+  // The cells are only cleared, so their memory is reused.
+  for (std::vector<unsigned> &cell : cell_indices_) {
+    cell.clear();
+  }
+  cell_indices_.resize(number_of_cells_[0] * number_of_cells_[1] *
+                       number_of_cells_[2]);
+  cell_of_.clear();
+
+  // The particles are visited in the order of their storage in Particles,
+  // which is also the order within each cell.
+  for (const ParticleData &p : particles) {
+    SizeType idx;
+    if (filling_ == CellFilling::AllInOne) {
+      idx = 0;
+    } else if (p.xsec_scaling_factor(timestep_duration) > 0.0) {
+      idx = filling_ == CellFilling::Cells ? cell_index_for(p) : 0;
+    } else {
+      continue;  // filter out the particles that can not interact
+    }
+    const unsigned storage_index = Particles::storage_index(p);
+    if (storage_index >= cell_of_.size()) {
+      cell_of_.resize(storage_index + 1, -1);
+    }
+    cell_of_[storage_index] = idx;
+    cell_indices_[idx].push_back(storage_index);
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::move_particles(const Particles &particles,
+                             double timestep_duration) {
+  visited_.assign(cell_of_.size(), false);
+  for (const ParticleData &p : particles) {
+    const unsigned storage_index = Particles::storage_index(p);
+    if (storage_index >= cell_of_.size()) {
+      cell_of_.resize(storage_index + 1, -1);
+      visited_.resize(storage_index + 1, false);
+    }
+    visited_[storage_index] = true;
+    const SizeType target = p.xsec_scaling_factor(timestep_duration) > 0.0
+                                ? cell_index_for(p)
+                                : -1;
+    if (cell_of_[storage_index] == target) {
+      continue;
+    }
+    if (cell_of_[storage_index] >= 0) {
+      erase_index(storage_index);
+    }
+    if (target >= 0) {
+      insert_index(target, storage_index);
+    }
+  }
+  // particles that were removed from the list since the last update
+  for (std::size_t i = 0; i < cell_of_.size(); ++i) {
+    if (!visited_[i] && cell_of_[i] >= 0) {
+      erase_index(i);
+    }
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::erase_index(unsigned storage_index) {
+  std::vector<unsigned> &cell = cell_indices_[cell_of_[storage_index]];
+  cell.erase(std::lower_bound(cell.begin(), cell.end(), storage_index));
+  cell_of_[storage_index] = -1;
+}
+
+template <GridOptions O>
+void Grid<O>::insert_index(SizeType cell_index, unsigned storage_index) {
+  std::vector<unsigned> &cell = cell_indices_[cell_index];
+  // keep the cell ordered like a newly filled one
+  cell.insert(std::lower_bound(cell.begin(), cell.end(), storage_index),
+              storage_index);
+  cell_of_[storage_index] = cell_index;
+}
+
+template <GridOptions O>
+void Grid<O>::replace(const ParticleList &to_remove,
+                      const ParticleList &to_add) {
+  for (const ParticleData &p : to_remove) {
+    const unsigned storage_index = Particles::storage_index(p);
+    if (storage_index < cell_of_.size() && cell_of_[storage_index] >= 0) {
+      erase_index(storage_index);
+    }
+  }
+  for (const ParticleData &p : to_add) {
+    const unsigned storage_index = Particles::storage_index(p);
+    if (storage_index >= cell_of_.size()) {
+      cell_of_.resize(storage_index + 1, -1);
+    }
+    insert_index(nearest_cell_index_for(p), storage_index);
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::surrounding_particles(const ParticleList &search_list,
+                                    const Particles &particles,
+                                    ParticleList &surrounding) const {
+  std::vector<SizeType> cells;
+  for (const ParticleData &p : search_list) {
+    const SizeType idx = nearest_cell_index_for(p);
+    const SizeType x = idx % number_of_cells_[0];
+    const SizeType y = (idx / number_of_cells_[0]) % number_of_cells_[1];
+    const SizeType z = idx / (number_of_cells_[0] * number_of_cells_[1]);
+    for (SizeType dz = -1; dz <= 1; ++dz) {
+      for (SizeType dy = -1; dy <= 1; ++dy) {
+        for (SizeType dx = -1; dx <= 1; ++dx) {
+          std::array<SizeType, 3> neighbor = {{x + dx, y + dy, z + dz}};
+          bool inside = true;
+          for (int i = 0; i < 3; ++i) {
+            if (neighbor[i] >= 0 && neighbor[i] < number_of_cells_[i]) {
+              continue;
+            }
+            if (O == GridOptions::PeriodicBoundaries) {
+              neighbor[i] = (neighbor[i] + number_of_cells_[i]) %
+                            number_of_cells_[i];
+            } else {
+              inside = false;
+            }
+          }
+          if (inside) {
+            cells.push_back(make_index(neighbor));
+          }
         }
-#endif
-        cells_[idx].push_back(p);
       }
     }
   }
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
 
-  logg[LGrid].debug(cells_);
+  std::vector<unsigned> indices;
+  for (const SizeType cell : cells) {
+    indices.insert(indices.end(), cell_indices_[cell].begin(),
+                   cell_indices_[cell].end());
+  }
+  std::sort(indices.begin(), indices.end());
+
+  surrounding.clear();
+  for (const unsigned storage_index : indices) {
+    const bool in_search_list = std::any_of(
+        search_list.begin(), search_list.end(),
+        [storage_index](const ParticleData &p) {
+          return Particles::storage_index(p) == storage_index;
+        });
+    if (!in_search_list) {
+      surrounding.push_back(particles.at_storage_index(storage_index));
+    }
+  }
+}
+
+template <GridOptions O>
+typename Grid<O>::SizeType Grid<O>::nearest_cell_index_for(
+    const ParticleData &p) const {
+  if (filling_ != CellFilling::Cells) {
+    return 0;
+  }
+  std::array<SizeType, 3> idx;
+  for (int i = 0; i < 3; ++i) {
+    const double x =
+        (p.position()[i + 1] - min_position_[i]) * index_factor_[i];
+    if (x < 0.) {
+      idx[i] = 0;
+    } else if (x >= number_of_cells_[i]) {
+      idx[i] = number_of_cells_[i] - 1;
+    } else {
+      idx[i] = std::floor(x);
+    }
+  }
+  return make_index(idx);
+}
+
+template <GridOptions O>
+typename Grid<O>::SizeType Grid<O>::cell_index_for(
+    const ParticleData &p) const {
+  // This simply calculates the distance to min_position_ and multiplies it
+  // with index_factor_ to determine the 3 x,y,z indexes to pass to make_index.
+  const SizeType idx = make_index(
+      std::floor((p.position()[1] - min_position_[0]) * index_factor_[0]),
+      std::floor((p.position()[2] - min_position_[1]) * index_factor_[1]),
+      std::floor((p.position()[3] - min_position_[2]) * index_factor_[2]));
+#ifndef NDEBUG
+  if (idx < 0 || idx >= SizeType(cell_indices_.size())) {
+    logg[LGrid].fatal(source_location,
+                      "\nan out-of-bounds access would be necessary for the "
+                      "particle ",
+                      p, "\nfor a grid with the following parameters:\nmin: ",
+                      min_position_, "\nlength: ", length_,
+                      "\ncells: ", number_of_cells_,
+                      "\nindex_factor: ", index_factor_,
+                      "\ncell_indices_.size: ", cell_indices_.size(),
+                      "\nrequested index: ", idx);
+    throw std::runtime_error("out-of-bounds grid access");
+  }
+#endif
+  return idx;
 }
 
 template <GridOptions Options>
@@ -284,47 +481,45 @@ static const std::initializer_list<GridBase::SizeType> MINUS_ONE_ZERO_ONE{-1, 0,
                                                                           1};
 
 template <>
-/// Specialization of iterate_cells
-void Grid<GridOptions::Normal>::iterate_cells(
-    const std::function<void(const ParticleList &)> &search_cell_callback,
-    const std::function<void(const ParticleList &, const ParticleList &)>
-        &neighbor_cell_callback) const {
-  std::array<SizeType, 3> search_index;
-  SizeType &x = search_index[0];
-  SizeType &y = search_index[1];
-  SizeType &z = search_index[2];
-  SizeType search_cell_index = 0;
-  for (z = 0; z < number_of_cells_[2]; ++z) {
-    for (y = 0; y < number_of_cells_[1]; ++y) {
-      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
-        assert(search_cell_index == make_index(search_index));
-        assert(search_cell_index >= 0);
-        assert(search_cell_index < SizeType(cells_.size()));
-        const ParticleList &search = cells_[search_cell_index];
-        search_cell_callback(search);
-
-        const auto &dz_list = z == number_of_cells_[2] - 1 ? ZERO : ZERO_ONE;
-        const auto &dy_list = number_of_cells_[1] == 1
-                                  ? ZERO
-                                  : y == 0 ? ZERO_ONE
-                                           : y == number_of_cells_[1] - 1
-                                                 ? MINUS_ONE_ZERO
-                                                 : MINUS_ONE_ZERO_ONE;
-        const auto &dx_list = number_of_cells_[0] == 1
-                                  ? ZERO
-                                  : x == 0 ? ZERO_ONE
-                                           : x == number_of_cells_[0] - 1
-                                                 ? MINUS_ONE_ZERO
-                                                 : MINUS_ONE_ZERO_ONE;
-        for (SizeType dz : dz_list) {
-          for (SizeType dy : dy_list) {
-            for (SizeType dx : dx_list) {
-              const auto di = make_index(dx, dy, dz);
-              if (di > 0) {
-                neighbor_cell_callback(search, cells_[search_cell_index + di]);
-              }
-            }
-          }
+/// Specialization of iterate_cell
+void Grid<GridOptions::Normal>::iterate_cell(
+    SizeType search_cell_index,
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback)
+    const {
+  const SizeType x = search_cell_index % number_of_cells_[0];
+  const SizeType y =
+      (search_cell_index / number_of_cells_[0]) % number_of_cells_[1];
+  const SizeType z =
+      search_cell_index / (number_of_cells_[0] * number_of_cells_[1]);
+  assert(search_cell_index == make_index(x, y, z));
+  assert(search_cell_index >= 0);
+  assert(search_cell_index < SizeType(cell_indices_.size()));
+  const ParticleListView search(*particles_, cell_indices_[search_cell_index]);
+  search_cell_callback(search);
+
+  const auto &dz_list = z == number_of_cells_[2] - 1 ? ZERO : ZERO_ONE;
+  const auto &dy_list = number_of_cells_[1] == 1
+                            ? ZERO
+                            : y == 0 ? ZERO_ONE
+                                     : y == number_of_cells_[1] - 1
+                                           ? MINUS_ONE_ZERO
+                                           : MINUS_ONE_ZERO_ONE;
+  const auto &dx_list = number_of_cells_[0] == 1
+                            ? ZERO
+                            : x == 0 ? ZERO_ONE
+                                     : x == number_of_cells_[0] - 1
+                                           ? MINUS_ONE_ZERO
+                                           : MINUS_ONE_ZERO_ONE;
+  for (SizeType dz : dz_list) {
+    for (SizeType dy : dy_list) {
+      for (SizeType dx : dx_list) {
+        const auto di = make_index(dx, dy, dz);
+        if (di > 0) {
+          neighbor_cell_callback(
+              search, ParticleListView(*particles_,
+                                       cell_indices_[search_cell_index + di]));
         }
       }
     }
@@ -350,138 +545,192 @@ struct NeighborLookup {
 };
 
 template <>
-/// Specialization of iterate_cells
-void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
-    const std::function<void(const ParticleList &)> &search_cell_callback,
-    const std::function<void(const ParticleList &, const ParticleList &)>
-        &neighbor_cell_callback) const {
-  std::array<SizeType, 3> search_index;
-  SizeType &x = search_index[0];
-  SizeType &y = search_index[1];
-  SizeType &z = search_index[2];
-  SizeType search_cell_index = 0;
+/// Specialization of iterate_cell
+void Grid<GridOptions::PeriodicBoundaries>::iterate_cell(
+    SizeType search_cell_index,
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback)
+    const {
+  assert(number_of_cells_[2] >= 2);
+  assert(number_of_cells_[1] >= 2);
+  assert(number_of_cells_[0] >= 2);
+
+  const std::array<SizeType, 3> search_index = {
+      search_cell_index % number_of_cells_[0],
+      (search_cell_index / number_of_cells_[0]) % number_of_cells_[1],
+      search_cell_index / (number_of_cells_[0] * number_of_cells_[1])};
+  const SizeType x = search_index[0];
+  const SizeType y = search_index[1];
+  const SizeType z = search_index[2];
 
   // defaults:
   std::array<NeighborLookup, 2> dz_list;
   std::array<NeighborLookup, 3> dy_list;
   std::array<NeighborLookup, 3> dx_list;
 
-  assert(number_of_cells_[2] >= 2);
-  assert(number_of_cells_[1] >= 2);
-  assert(number_of_cells_[0] >= 2);
+  dz_list[0].index = z;
+  dz_list[1].index = z + 1;
+  if (dz_list[1].index == number_of_cells_[2]) {
+    dz_list[1].index = 0;
+    dz_list[1].wrap = NeedsToWrap::MinusLength;
+  }
+  dy_list[0].index = y;
+  dy_list[1].index = y - 1;
+  dy_list[2].index = y + 1;
+  if (y == 0) {
+    dy_list[1] = dy_list[2];
+    dy_list[2].index = number_of_cells_[1] - 1;
+    dy_list[2].wrap = NeedsToWrap::PlusLength;
+  } else if (dy_list[2].index == number_of_cells_[1]) {
+    dy_list[2].index = 0;
+    dy_list[2].wrap = NeedsToWrap::MinusLength;
+  }
+  dx_list[0].index = x;
+  dx_list[1].index = x - 1;
+  dx_list[2].index = x + 1;
+  if (x == 0) {
+    dx_list[1] = dx_list[2];
+    dx_list[2].index = number_of_cells_[0] - 1;
+    dx_list[2].wrap = NeedsToWrap::PlusLength;
+  } else if (dx_list[2].index == number_of_cells_[0]) {
+    dx_list[2].index = 0;
+    dx_list[2].wrap = NeedsToWrap::MinusLength;
+  }
 
-  for (z = 0; z < number_of_cells_[2]; ++z) {
-    dz_list[0].index = z;
-    dz_list[1].index = z + 1;
-    if (dz_list[1].index == number_of_cells_[2]) {
-      dz_list[1].index = 0;
-      // last z in the loop, so no need to reset wrap again
-      dz_list[1].wrap = NeedsToWrap::MinusLength;
+  assert(search_cell_index == make_index(search_index));
+  assert(search_cell_index >= 0);
+  assert(search_cell_index < SizeType(cell_indices_.size()));
+  const ParticleListView search(*particles_, cell_indices_[search_cell_index]);
+  search_cell_callback(search);
+  /* The search cell is only copied once it has to be translated next to a
+   * neighbor cell on the other side of the grid. */
+  ParticleList translated_search;
+  bool is_translated = false;
+
+  auto virtual_search_index = search_index;
+  ThreeVector wrap_vector = {};  // no change
+  auto current_wrap_vector = wrap_vector;
+
+  for (const auto &dz : dz_list) {
+    if (dz.wrap == NeedsToWrap::MinusLength) {
+      // last dz in the loop, so no need to undo the wrap
+      wrap_vector[2] = -length_[2];
+      virtual_search_index[2] = -1;
     }
-    for (y = 0; y < number_of_cells_[1]; ++y) {
-      dy_list[0].index = y;
-      dy_list[1].index = y - 1;
-      dy_list[2].index = y + 1;
-      dy_list[2].wrap = NeedsToWrap::No;
-      if (y == 0) {
-        dy_list[1] = dy_list[2];
-        dy_list[2].index = number_of_cells_[1] - 1;
-        dy_list[2].wrap = NeedsToWrap::PlusLength;
-      } else if (dy_list[2].index == number_of_cells_[1]) {
-        dy_list[2].index = 0;
-        dy_list[2].wrap = NeedsToWrap::MinusLength;
+    for (const auto &dy : dy_list) {
+      // only the last dy in dy_list can wrap
+      if (dy.wrap == NeedsToWrap::MinusLength) {
+        wrap_vector[1] = -length_[1];
+        virtual_search_index[1] = -1;
+      } else if (dy.wrap == NeedsToWrap::PlusLength) {
+        wrap_vector[1] = length_[1];
+        virtual_search_index[1] = number_of_cells_[1];
       }
-      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
-        dx_list[0].index = x;
-        dx_list[1].index = x - 1;
-        dx_list[2].index = x + 1;
-        dx_list[2].wrap = NeedsToWrap::No;
-        if (x == 0) {
-          dx_list[1] = dx_list[2];
-          dx_list[2].index = number_of_cells_[0] - 1;
-          dx_list[2].wrap = NeedsToWrap::PlusLength;
-        } else if (dx_list[2].index == number_of_cells_[0]) {
-          dx_list[2].index = 0;
-          dx_list[2].wrap = NeedsToWrap::MinusLength;
+      for (const auto &dx : dx_list) {
+        // only the last dx in dx_list can wrap
+        if (dx.wrap == NeedsToWrap::MinusLength) {
+          wrap_vector[0] = -length_[0];
+          virtual_search_index[0] = -1;
+        } else if (dx.wrap == NeedsToWrap::PlusLength) {
+          wrap_vector[0] = length_[0];
+          virtual_search_index[0] = number_of_cells_[0];
+        }
+        assert(dx.index >= 0);
+        assert(dx.index < number_of_cells_[0]);
+        assert(dy.index >= 0);
+        assert(dy.index < number_of_cells_[1]);
+        assert(dz.index >= 0);
+        assert(dz.index < number_of_cells_[2]);
+        const auto neighbor_cell_index =
+            make_index(dx.index, dy.index, dz.index);
+        assert(neighbor_cell_index >= 0);
+        assert(neighbor_cell_index < SizeType(cell_indices_.size()));
+        if (neighbor_cell_index <= make_index(virtual_search_index)) {
+          continue;
         }
 
-        assert(search_cell_index == make_index(search_index));
-        assert(search_cell_index >= 0);
-        assert(search_cell_index < SizeType(cells_.size()));
-        ParticleList search = cells_[search_cell_index];
-        search_cell_callback(search);
-
-        auto virtual_search_index = search_index;
-        ThreeVector wrap_vector = {};  // no change
-        auto current_wrap_vector = wrap_vector;
-
-        for (const auto &dz : dz_list) {
-          if (dz.wrap == NeedsToWrap::MinusLength) {
-            // last dz in the loop, so no need to undo the wrap
-            wrap_vector[2] = -length_[2];
-            virtual_search_index[2] = -1;
-          }
-          for (const auto &dy : dy_list) {
-            // only the last dy in dy_list can wrap
-            if (dy.wrap == NeedsToWrap::MinusLength) {
-              wrap_vector[1] = -length_[1];
-              virtual_search_index[1] = -1;
-            } else if (dy.wrap == NeedsToWrap::PlusLength) {
-              wrap_vector[1] = length_[1];
-              virtual_search_index[1] = number_of_cells_[1];
-            }
-            for (const auto &dx : dx_list) {
-              // only the last dx in dx_list can wrap
-              if (dx.wrap == NeedsToWrap::MinusLength) {
-                wrap_vector[0] = -length_[0];
-                virtual_search_index[0] = -1;
-              } else if (dx.wrap == NeedsToWrap::PlusLength) {
-                wrap_vector[0] = length_[0];
-                virtual_search_index[0] = number_of_cells_[0];
-              }
-              assert(dx.index >= 0);
-              assert(dx.index < number_of_cells_[0]);
-              assert(dy.index >= 0);
-              assert(dy.index < number_of_cells_[1]);
-              assert(dz.index >= 0);
-              assert(dz.index < number_of_cells_[2]);
-              const auto neighbor_cell_index =
-                  make_index(dx.index, dy.index, dz.index);
-              assert(neighbor_cell_index >= 0);
-              assert(neighbor_cell_index < SizeType(cells_.size()));
-              if (neighbor_cell_index <= make_index(virtual_search_index)) {
-                continue;
-              }
-
-              if (wrap_vector != current_wrap_vector) {
-                logg[LGrid].debug("translating search cell by ",
-                                  wrap_vector - current_wrap_vector);
-                for_each(search, [&](ParticleData &p) {
-                  p = p.translated(wrap_vector - current_wrap_vector);
-                });
-                current_wrap_vector = wrap_vector;
-              }
-              neighbor_cell_callback(search, cells_[neighbor_cell_index]);
-            }
-            virtual_search_index[0] = search_index[0];
-            wrap_vector[0] = 0;
+        if (wrap_vector != current_wrap_vector) {
+          logg[LGrid].debug("translating search cell by ",
+                            wrap_vector - current_wrap_vector);
+          if (!is_translated) {
+            translated_search.assign(search.begin(), search.end());
+            is_translated = true;
           }
-          virtual_search_index[1] = search_index[1];
-          wrap_vector[1] = 0;
+          for_each(translated_search, [&](ParticleData &p) {
+            p = p.translated(wrap_vector - current_wrap_vector);
+          });
+          current_wrap_vector = wrap_vector;
+        }
+        const ParticleListView neighbors(*particles_,
+                                         cell_indices_[neighbor_cell_index]);
+        if (is_translated) {
+          neighbor_cell_callback(translated_search, neighbors);
+        } else {
+          neighbor_cell_callback(search, neighbors);
         }
       }
+      virtual_search_index[0] = search_index[0];
+      wrap_vector[0] = 0;
     }
+    virtual_search_index[1] = search_index[1];
+    wrap_vector[1] = 0;
   }
 }
 
-template Grid<GridOptions::Normal>::Grid(
-    const std::pair<std::array<double, 3>, std::array<double, 3>>
-        &min_and_length,
-    const Particles &particles, double max_interaction_length,
-    double timestep_duration, CellSizeStrategy strategy);
-template Grid<GridOptions::PeriodicBoundaries>::Grid(
-    const std::pair<std::array<double, 3>, std::array<double, 3>>
-        &min_and_length,
-    const Particles &particles, double max_interaction_length,
-    double timestep_duration, CellSizeStrategy strategy);
+template <GridOptions O>
+void Grid<O>::iterate_cells(
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback)
+    const {
+  const SizeType n_cells = cell_indices_.size();
+  for (SizeType cell = 0; cell < n_cells; ++cell) {
+    iterate_cell(cell, search_cell_callback, neighbor_cell_callback);
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::iterate_cells_parallel(
+    ThreadPool &pool,
+    const std::function<void(SizeType, const ParticleListView &)>
+        &search_cell_callback,
+    const std::function<void(SizeType, const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback)
+    const {
+  const SizeType n_cells = cell_indices_.size();
+  /* The cells are handed out one by one, because their occupation and
+   * therefore the work per cell varies strongly. */
+  std::atomic<SizeType> next_cell{0};
+  std::mutex failure_mutex;
+  std::exception_ptr failure;
+  auto work = [&]() {
+    try {
+      for (SizeType cell = next_cell++; cell < n_cells; cell = next_cell++) {
+        iterate_cell(
+            cell,
+            [&](const ParticleListView &search) {
+              search_cell_callback(cell, search);
+            },
+            [&](const ParticleListView &search,
+                const ParticleListView &neighbors) {
+              neighbor_cell_callback(cell, search, neighbors);
+            });
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(failure_mutex);
+      if (!failure) {
+        failure = std::current_exception();
+      }
+      next_cell = n_cells;
+    }
+  };
+  pool.run(work);
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+template class Grid<GridOptions::Normal>;
+template class Grid<GridOptions::PeriodicBoundaries>;
 }  // namespace smash
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "allocationpool.h"
 #include "lattice.h"
 #include "particles.h"
 #include "pauliblocking.h"
@@ -88,6 +89,27 @@ class Action {
    */
   virtual ~Action();
 
+  /**
+   * Actions are allocated from a pool, because many of them are short-lived,
+   * see allocation_pool.
+   *
+   * \param[in] size Size of the action in bytes.
+   * \return Memory for the action.
+   */
+  static void *operator new(std::size_t size) {
+    return allocation_pool::allocate(size);
+  }
+
+  /**
+   * Returns the memory of an action to the pool.
+   *
+   * \param[in] pointer Memory of the action.
+   * \param[in] size Size of the action in bytes.
+   */
+  static void operator delete(void *pointer, std::size_t size) noexcept {
+    allocation_pool::deallocate(pointer, size);
+  }
+
   /**
    * Determine whether one action takes place before another in time
    *
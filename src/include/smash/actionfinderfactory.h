@@ -41,7 +41,7 @@ class ActionFinderInterface {
    *         could possibly be executed in this time step.
    */
   virtual ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double gcell_vol,
+      const ParticleListView &search_list, double dt, const double gcell_vol,
       const std::vector<FourVector> &beam_momentum) const = 0;
   /**
    * Abstract function for finding actions, given two lists of particles,
@@ -58,8 +58,9 @@ class ActionFinderInterface {
    *         could possibly be executed in this time step.
    */
   virtual ActionList find_actions_with_neighbors(
-      const ParticleList &search_list, const ParticleList &neighbors_list,
-      double dt, const std::vector<FourVector> &beam_momentum) const = 0;
+      const ParticleListView &search_list,
+      const ParticleListView &neighbors_list, double dt,
+      const std::vector<FourVector> &beam_momentum) const = 0;
 
   /**
    * Abstract function for finding actions between a list of particles and
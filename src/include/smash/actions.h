@@ -8,12 +8,15 @@
 #define SRC_INCLUDE_SMASH_ACTIONS_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "action.h"
 #include "forwarddeclarations.h"
+#include "particles.h"
 
 namespace smash {
 
@@ -22,6 +25,14 @@ namespace smash {
  *
  * The Actions class abstracts the storage and manipulation of actions.
  *
+ * The actions are kept in a binary heap ordered by their time of execution.
+ * Actions at the same time are ordered by insertion, so the order in which
+ * they are popped does not depend on the actions that were removed before.
+ * In addition, the pending actions of every particle are indexed by its id,
+ * such that actions that became invalid because one of their incoming
+ * particles took part in another action can be removed right away with
+ * remove_invalid(), instead of staying in the heap until they are popped.
+ *
  * \note
  * The Actions object cannot be copied, because it does not make sense
  * semantically. Move semantics make sense and can be implemented when needed.
@@ -33,15 +44,12 @@ class Actions {
   /**
    * Creates a new Actions object from an ActionList.
    *
-   * The actions are stored in a heap and not sorted. The entries of
-   * the ActionList are rendered invalid by this constructor.
+   * The entries of the ActionList are rendered invalid by this constructor.
    *
    * \param[in] action_list The ActionList from which to construct the Actions
    *                    object
    */
-  explicit Actions(ActionList&& action_list) : data_(std::move(action_list)) {
-    std::make_heap(data_.begin(), data_.end(), cmp);
-  }
+  explicit Actions(ActionList&& action_list) { insert(std::move(action_list)); }
 
   /// Cannot be copied
   Actions(const Actions&) = delete;
@@ -49,7 +57,19 @@ class Actions {
   Actions& operator=(const Actions&) = delete;
 
   /// \return whether the list of actions is empty.
-  bool is_empty() const { return data_.empty(); }
+  bool is_empty() const { return heap_.empty(); }
+
+  /**
+   * \return The execution time of the first action [fm/c].
+   *
+   * \throw RuntimeError if the list is empty.
+   */
+  double earliest_time() const {
+    if (heap_.empty()) {
+      throw std::runtime_error("Empty actions list!");
+    }
+    return slots_[heap_.front()].action->time_of_execution();
+  }
 
   /**
    * Return the first action in the list and removes it from the list.
@@ -57,13 +77,10 @@ class Actions {
    * \throw RuntimeError if the list is empty.
    */
   ActionPtr pop() {
-    if (data_.empty()) {
+    if (heap_.empty()) {
       throw std::runtime_error("Empty actions list!");
     }
-    std::pop_heap(data_.begin(), data_.end(), cmp);
-    ActionPtr act = std::move(data_.back());
-    data_.pop_back();
-    return act;
+    return remove(heap_.front());
   }
 
   /**
@@ -87,47 +104,195 @@ class Actions {
    * \param[in] action The action to insert.
    */
   void insert(ActionPtr&& action) {
-    data_.push_back(std::move(action));
-    std::push_heap(data_.begin(), data_.end(), cmp);
+    SlotIndex slot;
+    if (free_slots_.empty()) {
+      slot = slots_.size();
+      slots_.emplace_back();
+    } else {
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    for (const ParticleData& p : action->incoming_particles()) {
+      pending_[p.id()].push_back(slot);
+    }
+    slots_[slot].action = std::move(action);
+    slots_[slot].order = next_order_++;
+    slots_[slot].heap_position = heap_.size();
+    heap_.push_back(slot);
+    sift_up(heap_.size() - 1);
+  }
+
+  /**
+   * Removes all pending actions of the given particles that are no longer
+   * valid, see Action::is_valid. This has to be called with the incoming
+   * particles of every performed action, which are the only particles whose
+   * pending actions can have become invalid.
+   *
+   * \param[in] changed Particles that took part in a performed action.
+   * \param[in] particles The current particles.
+   * \return The number of removed actions.
+   */
+  std::size_t remove_invalid(const ParticleList& changed,
+                             const Particles& particles) {
+    std::size_t removed = 0;
+    for (const ParticleData& p : changed) {
+      const auto found = pending_.find(p.id());
+      if (found == pending_.end()) {
+        continue;
+      }
+      // Copy the slots, because removing an action updates the list.
+      invalid_slots_.clear();
+      for (const SlotIndex slot : found->second) {
+        if (!slots_[slot].action->is_valid(particles)) {
+          invalid_slots_.push_back(slot);
+        }
+      }
+      for (const SlotIndex slot : invalid_slots_) {
+        remove(slot);
+        ++removed;
+      }
+    }
+    return removed;
   }
 
   /// \return Number of actions.
-  ActionList::size_type size() const { return data_.size(); }
+  ActionList::size_type size() const { return heap_.size(); }
 
   /// Delete all actions.
-  void clear() { data_.clear(); }
+  void clear() {
+    slots_.clear();
+    free_slots_.clear();
+    heap_.clear();
+    pending_.clear();
+  }
+
+ private:
+  /// Index of an action in slots_.
+  using SlotIndex = std::uint32_t;
+
+  /// Storage of one action.
+  struct Slot {
+    /// The action, nullptr for a free slot.
+    ActionPtr action;
+    /// Number of insertions before this action, to order equal times.
+    std::uint64_t order = 0;
+    /// Position of the slot in heap_.
+    std::size_t heap_position = 0;
+  };
 
-  /// \return an iterator to the earliest action.
-  std::vector<ActionPtr>::const_reverse_iterator begin() const {
-    return data_.crbegin();
+  /**
+   * \return Whether the action in slot \p a is executed before the one in
+   * slot \p b.
+   *
+   * \param[in] a First slot
+   * \param[in] b Second slot
+   */
+  bool earlier(SlotIndex a, SlotIndex b) const {
+    const double time_a = slots_[a].action->time_of_execution();
+    const double time_b = slots_[b].action->time_of_execution();
+    return time_a < time_b ||
+           (time_a == time_b && slots_[a].order < slots_[b].order);
   }
 
-  /// \return an iterator to the place following the last action.
-  std::vector<ActionPtr>::const_reverse_iterator end() const {
-    return data_.crend();
+  /**
+   * Places the element at \p position of the heap at its place, assuming
+   * that it is not later than its former value.
+   *
+   * \param[in] position Position in the heap.
+   */
+  void sift_up(std::size_t position) {
+    const SlotIndex slot = heap_[position];
+    while (position > 0) {
+      const std::size_t parent = (position - 1) / 2;
+      if (!earlier(slot, heap_[parent])) {
+        break;
+      }
+      place(heap_[parent], position);
+      position = parent;
+    }
+    place(slot, position);
   }
 
- private:
   /**
-   * Compare two action pointer such that the maximum is the most recent
-   * action.
+   * Places the element at \p position of the heap at its place, assuming
+   * that it is not earlier than its former value.
    *
-   * \param[in] a First action
-   * \param[in] b Second action
-   * \return Whether the first action will be executed later than the second.
+   * \param[in] position Position in the heap.
    */
-  static bool cmp(const ActionPtr& a, const ActionPtr& b) {
-    return a->time_of_execution() > b->time_of_execution();
+  void sift_down(std::size_t position) {
+    const SlotIndex slot = heap_[position];
+    while (true) {
+      std::size_t child = 2 * position + 1;
+      if (child >= heap_.size()) {
+        break;
+      }
+      if (child + 1 < heap_.size() && earlier(heap_[child + 1], heap_[child])) {
+        ++child;
+      }
+      if (!earlier(heap_[child], slot)) {
+        break;
+      }
+      place(heap_[child], position);
+      position = child;
+    }
+    place(slot, position);
+  }
+
+  /**
+   * Puts \p slot at \p position of the heap.
+   *
+   * \param[in] slot Slot to be placed.
+   * \param[in] position Position in the heap.
+   */
+  void place(SlotIndex slot, std::size_t position) {
+    heap_[position] = slot;
+    slots_[slot].heap_position = position;
   }
 
   /**
-   * Dynamic data.
+   * Removes the action in \p slot from the heap and the pending lists of its
+   * incoming particles.
    *
-   * Vector is likely the best container type here. Because std::sort requires
-   * random access iterators. Any linked data structure (e.g. list) thus
-   * requires a less efficient sort algorithm.
+   * \param[in] slot Slot of the action.
+   * \return The removed action.
    */
-  std::vector<ActionPtr> data_;
+  ActionPtr remove(SlotIndex slot) {
+    const std::size_t position = slots_[slot].heap_position;
+    const SlotIndex last = heap_.back();
+    heap_.pop_back();
+    if (last != slot) {
+      place(last, position);
+      if (position > 0 && earlier(last, heap_[(position - 1) / 2])) {
+        sift_up(position);
+      } else {
+        sift_down(position);
+      }
+    }
+    ActionPtr action = std::move(slots_[slot].action);
+    for (const ParticleData& p : action->incoming_particles()) {
+      const auto found = pending_.find(p.id());
+      std::vector<SlotIndex>& list = found->second;
+      list.erase(std::find(list.begin(), list.end(), slot));
+      if (list.empty()) {
+        pending_.erase(found);
+      }
+    }
+    free_slots_.push_back(slot);
+    return action;
+  }
+
+  /// Storage of the actions, which is reused after they are removed.
+  std::vector<Slot> slots_;
+  /// Slots that are not in use.
+  std::vector<SlotIndex> free_slots_;
+  /// Binary heap of the used slots, with the earliest action in front.
+  std::vector<SlotIndex> heap_;
+  /// Slots of the pending actions of each particle, keyed by particle id.
+  std::unordered_map<int, std::vector<SlotIndex>> pending_;
+  /// Scratch space of remove_invalid.
+  std::vector<SlotIndex> invalid_slots_;
+  /// Number of inserted actions.
+  std::uint64_t next_order_ = 0;
 };
 
 }  // namespace smash
@@ -0,0 +1,89 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ADAPTIVETIMESTEP_H_
+#define SRC_INCLUDE_SMASH_ADAPTIVETIMESTEP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * Chooses the duration of the next time step in the adaptive time step mode,
+ * see \key Time_Step_Mode.
+ *
+ * The time step is limited by
+ * \li the time scale on which the potentials change the momenta, multiplied
+ *     by a safety factor,
+ * \li the interaction rate: on average, a particle should take part in at
+ *     most a given number of interactions per time step,
+ * \li a minimal and a maximal duration.
+ *
+ * A time step that exceeds these limits is shrunk right away. Otherwise, the
+ * time step grows by a constant factor per step, such that the dilute late
+ * stage of a collision is run with few long time steps and the grid and the
+ * lattices are not rebuilt needlessly.
+ */
+class AdaptiveTimeStep {
+ public:
+  /**
+   * Create the controller.
+   *
+   * \param[in] min_dt Smallest allowed time step [fm/c].
+   * \param[in] max_dt Largest allowed time step [fm/c].
+   * \param[in] force_safety_factor Fraction of the time scale of the momentum
+   *            change due to the potentials that one time step may last.
+   * \param[in] max_interactions_per_particle Number of interactions per
+   *            particle that one time step should contain on average.
+   * \param[in] growth_factor Factor by which the time step grows at most
+   *            from one step to the next.
+   * \throw std::invalid_argument if the parameters are not positive,
+   *        \p max_dt is smaller than \p min_dt or \p growth_factor is smaller
+   *        than 1.
+   */
+  AdaptiveTimeStep(double min_dt, double max_dt, double force_safety_factor,
+                   double max_interactions_per_particle, double growth_factor);
+
+  /**
+   * \return The duration of the next time step [fm/c].
+   *
+   * \param[in] dt Duration of the last time step [fm/c].
+   * \param[in] force_time_scale Shortest time scale of the momentum change due
+   *            to the potentials in the last time step [fm/c], infinity
+   *            without potentials.
+   * \param[in] interactions Number of interactions in the last time step.
+   * \param[in] n_particles Number of particles.
+   */
+  double next_timestep(double dt, double force_time_scale,
+                       uint64_t interactions, std::size_t n_particles) const;
+
+  /// \return Smallest allowed time step [fm/c].
+  double min_timestep() const { return min_dt_; }
+  /// \return Largest allowed time step [fm/c].
+  double max_timestep() const { return max_dt_; }
+
+ private:
+  /// Smallest allowed time step [fm/c]
+  const double min_dt_;
+  /// Largest allowed time step [fm/c]
+  const double max_dt_;
+  /// Allowed fraction of the time scale of the momentum change
+  const double force_safety_factor_;
+  /// Average number of interactions per particle and time step
+  const double max_interactions_per_particle_;
+  /// Maximal growth of the time step from one step to the next
+  const double growth_factor_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ADAPTIVETIMESTEP_H_
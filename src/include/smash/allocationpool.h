@@ -0,0 +1,66 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ALLOCATIONPOOL_H_
+#define SRC_INCLUDE_SMASH_ALLOCATIONPOOL_H_
+
+#include <cstddef>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * Recycling of the memory of small, short-lived objects.
+ *
+ * Actions and process branches are created by the thousands in every time
+ * step and most of them are destroyed right away. Their classes therefore
+ * allocate through this pool: freed blocks are kept in a free list of the
+ * freeing thread, sorted by size, and handed out again by the next
+ * allocation of the same size on that thread. Threads do not contend for
+ * these lists.
+ *
+ * Blocks that are in use do not belong to any pool, so an object may be
+ * freed by another thread than the one that allocated it. This is the rule
+ * rather than the exception: actions found on the finder threads are freed
+ * by the main thread, and the finder threads only live for one time step.
+ * Therefore a thread with too many free blocks of one size hands a batch of
+ * them over to a depot shared by all threads, and an exiting thread hands
+ * over all of its blocks. A thread without free blocks of the requested
+ * size takes a batch from the depot before calling the global allocator.
+ * The mutex of the depot is only locked once per batch. The number of blocks
+ * kept per thread and in the depot is limited, and the depot releases its
+ * blocks at the end of the program.
+ */
+namespace allocation_pool {
+
+/**
+ * Allocates memory from the free list of the current thread, which is
+ * refilled from the depot if needed.
+ *
+ * \param[in] size Number of bytes.
+ * \return Pointer to the memory, aligned like by the global operator new.
+ * \throw std::bad_alloc if no memory is available.
+ */
+void *allocate(std::size_t size);
+
+/**
+ * Returns memory obtained from allocate() to the free list of the current
+ * thread, from where it may move on to the depot.
+ *
+ * \param[in] pointer Memory to be returned.
+ * \param[in] size Number of bytes, as passed to allocate().
+ */
+void deallocate(void *pointer, std::size_t size) noexcept;
+
+}  // namespace allocation_pool
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ALLOCATIONPOOL_H_
@@ -102,6 +102,18 @@ class BoxModus : public ModusDefault {
             strategy};
   }
 
+  /// \copydoc smash::ModusDefault::GridType
+  using GridType = Grid<GridOptions::PeriodicBoundaries>;
+
+  /// \copydoc smash::ModusDefault::update_grid
+  void update_grid(
+      GridType &grid, const Particles &particles, double min_cell_length,
+      double timestep_duration,
+      CellSizeStrategy strategy = CellSizeStrategy::Optimal) const {
+    grid.update({{0, 0, 0}, {length_, length_, length_}}, particles,
+                min_cell_length, timestep_duration, strategy);
+  }
+
   /**
    * Creates GrandCanThermalizer. (Special Box implementation.)
    *
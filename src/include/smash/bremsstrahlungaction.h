@@ -171,7 +171,7 @@ class BremsstrahlungAction : public ScatterAction {
    * Create interpolation objects for tabularized cross sections:
    * total cross section, differential dSigma/dk, differential dSigma/dtheta
    */
-  void create_interpolations();
+  static void create_interpolations();
 
   /**
    * Computes the total cross section of the bremsstrahlung process.
@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BUFFEREDOUTPUT_H_
+#define SRC_INCLUDE_SMASH_BUFFEREDOUTPUT_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "outputinterface.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * \brief Records all output calls of one event for later replay
+ *
+ * If several events are run concurrently (see \key Threads in
+ * \ref input_general_), every worker writes to BufferedOutput objects instead
+ * of the real outputs. Each call stores a snapshot of its arguments, such that
+ * the complete event can later be replayed onto the real output with
+ * replay_onto(). The main thread does this in event order, so the files
+ * written in a multi-threaded run are identical to those of a serial run.
+ */
+class BufferedOutput : public OutputInterface {
+ public:
+  /**
+   * Construct a buffer that stands in for the given output. The dilepton,
+   * photon and initial conditions flags are taken over from \p target, so
+   * the buffer is treated exactly like the output it records for.
+   *
+   * \param[in] target The output that will eventually receive the calls.
+   */
+  explicit BufferedOutput(const OutputInterface &target);
+
+  /**
+   * Record the event start.
+   * \param[in] particles Particles at the event start; they are copied.
+   * \param[in] event_number Number of the current event.
+   * \param[in] info Event info, see \ref event_info
+   */
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &info) override;
+
+  /**
+   * Record the event end.
+   * \param[in] particles Particles at the event end; they are copied.
+   * \param[in] event_number Number of the current event.
+   * \param[in] info Event info, see \ref event_info
+   */
+  void at_eventend(const Particles &particles, const int event_number,
+                   const EventInfo &info) override;
+
+  /**
+   * Record an interaction. Incoming and outgoing particles, weights, process
+   * type and time are stored.
+   * \param[in] action The performed action.
+   * \param[in] density The density at the interaction point.
+   */
+  void at_interaction(const Action &action, const double density) override;
+
+  /**
+   * Record an intermediate output. The clock is stored by its current time
+   * and timestep size.
+   * \param[in] particles Current particles; they are copied.
+   * \param[in] clock System clock.
+   * \param[in] dens_param Parameters for density calculation.
+   * \param[in] info Event info, see \ref event_info
+   */
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventInfo &info) override;
+
+  /**
+   * Record a density lattice output. The lattice is copied.
+   * \param[in] tq Thermodynamic quantity to be written.
+   * \param[in] dt Type of density.
+   * \param[in] lattice Lattice of tabulated values.
+   */
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dt,
+      RectangularLattice<DensityOnLattice> &lattice) override;
+
+  /**
+   * Record an energy-momentum tensor lattice output. The lattice is copied.
+   * \param[in] tq Thermodynamic quantity to be written.
+   * \param[in] dt Type of density.
+   * \param[in] lattice Lattice of tabulated values.
+   */
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dt,
+      RectangularLattice<EnergyMomentumTensor> &lattice) override;
+
+  /**
+   * The thermalizer cannot be snapshotted, therefore it is not supported.
+   * \throw std::logic_error always
+   */
+  void thermodynamics_output(const GrandCanThermalizer &gct) override;
+
+  /**
+   * Pass all recorded calls in their original order to \p target and clear
+   * the buffer.
+   *
+   * \param[in] target The output receiving the calls.
+   */
+  void replay_onto(OutputInterface &target);
+
+  /// \return Whether no call was recorded since the last replay.
+  bool empty() const { return records_.empty(); }
+
+ private:
+  /// One recorded output call, to be applied to the real output.
+  using Record = std::function<void(OutputInterface &)>;
+
+  /// Recorded calls in the order they were made.
+  std::vector<Record> records_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BUFFEREDOUTPUT_H_
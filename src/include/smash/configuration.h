@@ -389,6 +389,15 @@ namespace smash {
  * additionally have to be uncommented in the used decaymodes.txt (see also note
  * below).
  *
+ * \key Accumulated_Shining (bool, optional, default = false):\n
+ * \li \key true - Every resonance shines once for every segment of its
+ * lifetime: when it is destroyed in an interaction, at every output time and
+ * at the end of every time step. The shining weight is integrated over the
+ * segment. This produces fewer, but heavier dilepton entries and makes
+ * dilepton runs hardly slower than runs without dileptons.
+ * \li \key false - All resonances shine every time the particles are
+ * propagated, i.e. before every single action.
+ *
  * Remember to also activate the dilepton output in the output section.
  *
  * \n
@@ -850,9 +859,12 @@ class Configuration {
       if (s == "Fixed") {
         return TimeStepMode::Fixed;
       }
-      throw IncorrectTypeInAssignment("The value for key \"" +
-                                      std::string(key_) +
-                                      "\" should be \"None\" or \"Fixed\".");
+      if (s == "Adaptive") {
+        return TimeStepMode::Adaptive;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) +
+          "\" should be \"None\", \"Fixed\" or \"Adaptive\".");
     }
 
     /**
@@ -1066,6 +1078,14 @@ class Configuration {
   /// Moving is fine
   Configuration &operator=(Configuration &&) = default;
 
+  /**
+   * Creates an independent copy of the configuration. In contrast to the copy
+   * constructor, values taken from the returned object remain in this one.
+   *
+   * \return Deep copy of the configuration tree.
+   */
+  Configuration clone() const { return Configuration(YAML::Clone(root_node_)); }
+
   /**
    * Merge the configuration in \p yaml into the existing tree.
    *
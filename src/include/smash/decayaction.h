@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "action.h"
+#include "decaymodes.h"
 
 namespace smash {
 
@@ -47,6 +48,18 @@ class DecayAction : public Action {
    */
   void add_decay(DecayBranchPtr p);
 
+  /**
+   * Add all decay modes of the decaying particle at once, with the partial
+   * widths given by \p widths (see ParticleType::get_partial_widths). No
+   * branch objects are created; the executed mode is looked up in the decay
+   * mode list of the particle type.
+   *
+   * This cannot be combined with add_decays(DecayBranchList) or add_decay().
+   *
+   * \param[in] widths Partial widths indexed like the decay mode list.
+   */
+  void add_decays(const DecayWidths &widths);
+
   /**
    * Generate the final state of the decay process.
    * Performs a decay of one particle to two or three particles.
@@ -93,9 +106,19 @@ class DecayAction : public Action {
    */
   void format_debug_output(std::ostream &out) const override;
 
+  /**
+   * Sample one of the decay modes according to mode_widths_.
+   * \return Index of the chosen mode in the decay mode list.
+   * \throw InvalidDecay if all widths vanish.
+   */
+  std::size_t choose_mode() const;
+
   /// List of possible decays
   DecayBranchList decay_channels_;
 
+  /// Partial widths of all decay modes, alternative to decay_channels_
+  DecayWidths mode_widths_;
+
   /// total decay width
   double total_width_;
 
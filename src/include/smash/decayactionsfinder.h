@@ -36,17 +36,21 @@ class DecayActionsFinder : public ActionFinderInterface {
   /**
    * Check the whole particle list for decays.
    *
+   * A decay time is sampled for every resonance and a decay is returned if it
+   * happens within \p dt. With an infinite \p dt, the decays of all
+   * resonances are scheduled at once, see \key Event_Driven_Decays.
+   *
    * \param[in] search_list All particles in grid cell.
    * \param[in] dt Size of timestep [fm]
    * \return List with the found (Decay)Action objects.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double,
+      const ParticleListView &search_list, double dt, const double,
       const std::vector<FourVector> &) const override;
 
   /// Ignore the neighbor searches for decays
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, double,
+      const ParticleListView &, const ParticleListView &, double,
       const std::vector<FourVector> &) const override {
     return {};
   }
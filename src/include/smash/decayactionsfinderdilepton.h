@@ -42,6 +42,33 @@ class DecayActionsFinderDilepton {
   void shine(const Particles& search_list, OutputInterface* output,
              double dt) const;
 
+  /**
+   * Shine the dileptons of all particles for the time they existed since the
+   * last shining, in one go. Each particle shines from the latest of
+   * \p since, its last interaction and its formation time up to its current
+   * time. As the momentum of a particle only changes in interactions and in
+   * the potential update at the end of a time step, this is equivalent to
+   * shining it at every propagation, but it evaluates the widths only once.
+   *
+   * \param[in] search_list List of particles, propagated to the current time.
+   * \param[in] output Pointer to the dilepton output.
+   * \param[in] since Time up to which all particles were already shone [fm].
+   */
+  void shine_accumulated(const Particles& search_list, OutputInterface* output,
+                         double since) const;
+
+  /**
+   * Shine the dileptons of particles that are about to be destroyed, see
+   * above.
+   *
+   * \param[in] search_list Incoming particles of a performed action, at the
+   *            time of the action.
+   * \param[in] output Pointer to the dilepton output.
+   * \param[in] since Time up to which all particles were already shone [fm].
+   */
+  void shine_accumulated(const ParticleList& search_list,
+                         OutputInterface* output, double since) const;
+
   /**
    * Shine dileptons from resonances at the end of the simulation.
    *
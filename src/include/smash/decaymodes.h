@@ -7,6 +7,9 @@
 #ifndef SRC_INCLUDE_SMASH_DECAYMODES_H_
 #define SRC_INCLUDE_SMASH_DECAYMODES_H_
 
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -35,6 +38,7 @@ class DecayModes {
    * \param[in] ratio the weight to add to the current mode
    * \param[in] L angular momentum
    * \param[in] particle_types a list of the products of the decay
+   * \throw LoadFailure if the mode would exceed DecayWidths::capacity
    */
   void add_mode(ParticleTypePtr mother, double ratio, int L,
                 ParticleTypePtrList particle_types);
@@ -132,6 +136,73 @@ class DecayModes {
   static std::vector<DecayModes> *all_decay_modes;
 };
 
+/**
+ * \ingroup data
+ *
+ * The mass-dependent partial widths of all decay modes of one particle,
+ * indexed like DecayModes::decay_mode_list().
+ *
+ * The buffer has a fixed capacity and is filled by
+ * ParticleType::get_partial_widths without any heap allocation. Unlike a
+ * DecayBranchList, no branch objects are created; the decay mode list
+ * already holds them, so a DecayAction only looks up the mode it executes.
+ */
+class DecayWidths {
+ public:
+  /// Maximal number of decay modes of one particle type.
+  static constexpr std::size_t capacity = 32;
+
+  /**
+   * Set the number of modes and reset all widths to 0.
+   *
+   * \param[in] n Number of decay modes, at most capacity.
+   */
+  void reset(std::size_t n) {
+    assert(n <= capacity);
+    size_ = n;
+    total_ = 0.;
+    widths_.fill(0.);
+  }
+
+  /**
+   * Set the width of one mode.
+   *
+   * \param[in] i Index of the mode in the decay mode list.
+   * \param[in] w Partial width [GeV], must not be negative.
+   */
+  void set(std::size_t i, double w) {
+    assert(i < size_ && w >= 0.);
+    total_ += w - widths_[i];
+    widths_[i] = w;
+  }
+
+  /// \return Number of decay modes, including those with vanishing width.
+  std::size_t size() const { return size_; }
+
+  /// \return Partial width of the mode with index \p i.
+  double operator[](std::size_t i) const { return widths_[i]; }
+
+  /// \return Sum of all partial widths.
+  double total() const { return total_; }
+
+  /// \return Number of modes with non-vanishing width.
+  std::size_t number_of_open_modes() const {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+      n += widths_[i] > 0.;
+    }
+    return n;
+  }
+
+ private:
+  /// Partial widths, only the first size_ entries are used
+  std::array<double, capacity> widths_ = {};
+  /// Number of decay modes
+  std::size_t size_ = 0;
+  /// Sum of the partial widths
+  double total_ = 0.;
+};
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DECAYMODES_H_
@@ -79,6 +79,13 @@ class DecayType {
   virtual double in_width(double m0, double G0, double m, double m1,
                           double m2) const = 0;
 
+  /**
+   * Build the tabulations needed by width() and in_width(), if this decay
+   * type uses any. They are otherwise built on first use, which must not
+   * happen while several threads access the decay type concurrently.
+   */
+  virtual void tabulate() const {}
+
  protected:
   /// final-state particles of the decay
   ParticleTypePtrList particle_types_;
@@ -204,6 +211,7 @@ class TwoBodyDecaySemistable : public TwoBodyDecay {
    */
   double in_width(double m0, double G0, double m, double m1,
                   double m2) const override;
+  void tabulate() const override;
 
  protected:
   double rho(double m) const override;
@@ -246,6 +254,7 @@ class TwoBodyDecayUnstable : public TwoBodyDecay {
   double width(double m0, double G0, double m) const override;
   double in_width(double m0, double G0, double m, double m1,
                   double m2) const override;
+  void tabulate() const override;
 
  protected:
   double rho(double m) const override;
@@ -342,6 +351,7 @@ class ThreeBodyDecayDilepton : public ThreeBodyDecay {
                            double m_other, ParticleTypePtr other,
                            ParticleTypePtr t);
   double width(double m0, double G0, double m) const override;
+  void tabulate() const override;
 
  protected:
   /// Tabulation of the resonance integrals.
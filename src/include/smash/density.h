@@ -9,7 +9,12 @@
 #ifndef SRC_INCLUDE_SMASH_DENSITY_H_
 #define SRC_INCLUDE_SMASH_DENSITY_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <tuple>
 #include <typeinfo>
 #include <utility>
@@ -23,6 +28,8 @@
 #include "particledata.h"
 #include "particles.h"
 #include "pdgcode.h"
+#include "tabulation.h"
+#include "threadpool.h"
 #include "threevector.h"
 
 namespace smash {
@@ -142,6 +149,30 @@ class DensityParameters {
    */
   double norm_factor_sf() const { return norm_factor_sf_; }
 
+  /**
+   * Tabulate the Gaussian of the smearing kernel as a function of the
+   * squared rest-frame distance. unnormalized_smearing_factor then
+   * interpolates it linearly instead of evaluating an exponential for every
+   * point. The table covers the whole range up to the cut-off radius, so the
+   * Lorentz contraction is treated exactly as before.
+   *
+   * \param[in] tolerance Largest absolute deviation of the tabulated Gaussian
+   *            from the exact one, which is 1 at its peak. For 0, the
+   *            exponential is evaluated.
+   * \throw std::invalid_argument if the tolerance is negative
+   */
+  void tabulate_kernel(double tolerance);
+
+  /**
+   * \return \f$ \exp(-x) \f$, tabulated if tabulate_kernel() was called
+   * \param[in] x Squared rest-frame distance over \f$ 2 \sigma^2 \f$,
+   *            at most (r_cut / \f$ \sigma)^2 / 2 \f$.
+   */
+  double kernel(double x) const {
+    return kernel_ ? kernel_->get_value_linear(x, Extrapolation::Const)
+                   : std::exp(-x);
+  }
+
  private:
   /// Gaussian smearing width [fm]
   const double sig_;
@@ -155,6 +186,8 @@ class DensityParameters {
   double norm_factor_sf_;
   /// Testparticle number
   const int ntest_;
+  /// Tabulated Gaussian, see tabulate_kernel(); nullptr if not tabulated
+  std::shared_ptr<const Tabulation> kernel_;
 };
 
 /**
@@ -263,6 +296,19 @@ class DensityOnLattice {
         jmu_neg_(FourVector()),
         djmu_dx_({FourVector(), FourVector(), FourVector(), FourVector()}) {}
 
+  /**
+   * Construct a node from already computed currents and derivatives.
+   *
+   * \param[in] jmu_pos Four-current density of the positively charged
+   *            particles.
+   * \param[in] jmu_neg Four-current density of the negatively charged
+   *            particles.
+   * \param[in] djmu_dx Time and spatial derivatives of the net current.
+   */
+  DensityOnLattice(const FourVector &jmu_pos, const FourVector &jmu_neg,
+                   const std::array<FourVector, 4> &djmu_dx)
+      : jmu_pos_(jmu_pos), jmu_neg_(jmu_neg), djmu_dx_(djmu_dx) {}
+
   /**
    * Adds particle to 4-current: \f$j^{\mu} += p^{\mu}/p^0 \cdot factor \f$.
    * Two private class members jmu_pos_ and jmu_neg_ indicating the 4-current
@@ -323,7 +369,7 @@ class DensityOnLattice {
    * \param[in] norm_factor Normalization factor
    * \return Net Eckart density on the local lattice [fm\f$^{-3}\f$]
    */
-  double density(const double norm_factor = 1.0) {
+  double density(const double norm_factor = 1.0) const {
     return (jmu_pos_.abs() - jmu_neg_.abs()) * norm_factor;
   }
 
@@ -333,7 +379,7 @@ class DensityOnLattice {
    * \param[in] norm_factor Normalization factor
    * \return \f$\nabla\times\j\f$ [fm \f$^{-4}\f$]
    */
-  ThreeVector rot_j(const double norm_factor = 1.0) {
+  ThreeVector rot_j(const double norm_factor = 1.0) const {
     ThreeVector j_rot = ThreeVector();
     j_rot.set_x1(djmu_dx_[2].x3() - djmu_dx_[3].x2());
     j_rot.set_x2(djmu_dx_[3].x1() - djmu_dx_[1].x3());
@@ -348,7 +394,7 @@ class DensityOnLattice {
    * \param[in] norm_factor Normalization factor
    * \return \f$\nabla\rho\f$ [fm \f$^{-4}\f$]
    */
-  ThreeVector grad_rho(const double norm_factor = 1.0) {
+  ThreeVector grad_rho(const double norm_factor = 1.0) const {
     ThreeVector rho_grad = ThreeVector();
     for (int i = 1; i < 4; i++) {
       rho_grad[i - 1] = djmu_dx_[i].x0() * norm_factor;
@@ -362,7 +408,7 @@ class DensityOnLattice {
    * \param[in] norm_factor Normalization factor
    * \return \f$\partial_t \vec j\f$ [fm \f$^{-4}\f$]
    */
-  ThreeVector dj_dt(const double norm_factor = 1.0) {
+  ThreeVector dj_dt(const double norm_factor = 1.0) const {
     return djmu_dx_[0].threevec() * norm_factor;
   }
 
@@ -387,56 +433,202 @@ class DensityOnLattice {
 typedef RectangularLattice<DensityOnLattice> DensityLattice;
 
 /**
- * Updates the contents on the lattice.
+ * Updates the contents of several lattices of identical structure in one
+ * pass over the particles.
  *
- * \param[out] lat The lattice on which the content will be updated
+ * The smearing factor of every particle at every node is calculated only
+ * once and added to all lattices, each with the density factor of its own
+ * density type. This is considerably cheaper than updating the lattices one
+ * after another, e.g. for the baryon and the isospin density of the
+ * potentials. Lattices which are nullptr or which are not due for \p update
+ * are skipped.
+ *
+ * The smearing can be distributed over the threads of a pool. Every thread
+ * fills whole z layers of the lattices and visits the particles in the same
+ * order, so every node receives its contributions in exactly the same order
+ * as in a serial update. The result is therefore bitwise identical for any
+ * number of threads.
+ *
+ * \param[out] lattices The lattices to be updated, together with the
+ *             density type to be computed on each of them
  * \param[in] update tells if called for update at printout or at timestep
- * \param[in] dens_type density type to be computed on the lattice
  * \param[in] par a structure containing testparticles number and gaussian
  *            smearing parameters.
  * \param[in] particles the particles vector
  * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool Threads filling the lattices, nullptr to fill them on the
+ *            calling thread only
  * \tparam T LatticeType
+ * \throw std::invalid_argument if the lattices do not have identical sizes,
+ *        cell numbers, origins and boundary conditions
  */
 template <typename T>
-void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
-                    const DensityType dens_type, const DensityParameters &par,
-                    const Particles &particles,
-                    const bool compute_gradient = false) {
-  // Do not proceed if lattice does not exists/update not required
-  if (lat == nullptr || lat->when_update() != update) {
+void update_lattices(
+    const std::vector<std::pair<RectangularLattice<T> *, DensityType>>
+        &lattices,
+    const LatticeUpdate update, const DensityParameters &par,
+    const Particles &particles, const bool compute_gradient = false,
+    ThreadPool *pool = nullptr) {
+  // Only keep the lattices that exist and need an update
+  std::vector<std::pair<RectangularLattice<T> *, DensityType>> targets;
+  for (const auto &lattice : lattices) {
+    if (lattice.first == nullptr || lattice.first->when_update() != update) {
+      continue;
+    }
+    if (!targets.empty() &&
+        !lattice.first->identical_to_lattice(targets.front().first)) {
+      throw std::invalid_argument(
+          "Lattices updated in one pass need to have the same structure.");
+    }
+    lattice.first->reset();
+    targets.push_back(lattice);
+  }
+  if (targets.empty()) {
     return;
   }
-  lat->reset();
+  RectangularLattice<T> *const lat = targets.front().first;
+  const size_t n_targets = targets.size();
   const double norm_factor = par.norm_factor_sf();
+
+  /* The particles contributing to any of the densities, with their inverse
+   * mass, and their density factors for all lattices */
+  struct Source {
+    const ParticleData *part;
+    double m_inv;
+  };
+  std::vector<Source> sources;
+  std::vector<double> dens_factors;
+  sources.reserve(particles.size());
+  dens_factors.reserve(particles.size() * n_targets);
   for (const auto &part : particles) {
-    const double dens_factor = density_factor(part.type(), dens_type);
-    if (std::abs(dens_factor) < really_small) {
-      continue;
+    bool contributes = false;
+    for (const auto &target : targets) {
+      const double dens_factor = density_factor(part.type(), target.second);
+      dens_factors.push_back(dens_factor);
+      contributes = contributes || std::abs(dens_factor) >= really_small;
     }
     const FourVector p = part.momentum();
     const double m = p.abs();
-    if (unlikely(m < really_small)) {
+    if (contributes && unlikely(m < really_small)) {
       logg[LDensity].warn("Gaussian smearing is undefined for momentum ", p);
+      contributes = false;
+    }
+    if (!contributes) {
+      dens_factors.resize(dens_factors.size() - n_targets);
       continue;
     }
-    const double m_inv = 1.0 / m;
-
-    const ThreeVector pos = part.position().threevec();
-    lat->iterate_in_radius(
-        pos, par.r_cut(), [&](T &node, int ix, int iy, int iz) {
-          const ThreeVector r = lat->cell_center(ix, iy, iz);
-          const auto sf = unnormalized_smearing_factor(pos - r, p, m_inv, par,
-                                                       compute_gradient);
-          if (sf.first * norm_factor > really_small / par.ntest()) {
-            node.add_particle(part, sf.first * norm_factor * dens_factor);
-          }
-          if (compute_gradient) {
-            node.add_particle_for_derivatives(part, dens_factor,
-                                              sf.second * norm_factor);
-          }
-        });
+    sources.push_back({&part, 1.0 / m});
+  }
+
+  // Smear all sources onto the z layers [z_begin, z_end)
+  auto smear = [&](int z_begin, int z_end) {
+    for (size_t s = 0; s < sources.size(); s++) {
+      const ParticleData &part = *sources[s].part;
+      const double *const factors = &dens_factors[s * n_targets];
+      const FourVector p = part.momentum();
+      const ThreeVector pos = part.position().threevec();
+      lat->iterate_in_radius(
+          pos, par.r_cut(), z_begin, z_end,
+          [&](T &node, int ix, int iy, int iz) {
+            const ThreeVector r = lat->cell_center(ix, iy, iz);
+            const auto sf = unnormalized_smearing_factor(
+                pos - r, p, sources[s].m_inv, par, compute_gradient);
+            const bool significant =
+                sf.first * norm_factor > really_small / par.ntest();
+            for (size_t j = 0; j < n_targets; j++) {
+              if (std::abs(factors[j]) < really_small) {
+                continue;
+              }
+              T &target_node =
+                  j == 0 ? node : targets[j].first->node(ix, iy, iz);
+              if (significant) {
+                target_node.add_particle(part,
+                                         sf.first * norm_factor * factors[j]);
+              }
+              if (compute_gradient) {
+                target_node.add_particle_for_derivatives(
+                    part, factors[j], sf.second * norm_factor);
+              }
+            }
+          });
+    }
+  };
+
+  const int n_layers = lat->dimensions()[2];
+  if (pool == nullptr || pool->size() <= 1 || n_layers <= 1) {
+    smear(0, n_layers);
+    return;
   }
+  /* The layers are handed out in a few slabs per thread, which balances the
+   * load when the particles are not distributed evenly in z. */
+  const int n_slabs = std::min(n_layers, 4 * pool->size());
+  std::atomic<int> next_slab{0};
+  auto work = [&]() {
+    for (int slab = next_slab++; slab < n_slabs; slab = next_slab++) {
+      smear(slab * n_layers / n_slabs, (slab + 1) * n_layers / n_slabs);
+    }
+  };
+  pool->run(work);
+}
+
+/**
+ * Updates density lattices like update_lattices(), but computes the smeared
+ * densities by a convolution instead of smearing every particle.
+ *
+ * The particles are first assigned to the 8 surrounding nodes with
+ * cloud-in-cell weights. These fields are then convolved with a Gaussian,
+ * separately along x, y and z, whose width is reduced by the broadening of
+ * the cloud-in-cell assignment. The gradients follow from a convolution with
+ * the derivative of the Gaussian. The cost therefore scales with the number
+ * of lattice nodes instead of the number of particles times the nodes within
+ * the cut-off radius, which pays off for many test particles.
+ *
+ * The results are an approximation of those of update_lattices(): the
+ * Gaussian is not Lorentz contracted, it is cut off at a box instead of a
+ * sphere, and particles more than half a cell outside a non-periodic
+ * lattice are not taken into account. The Gaussian is normalized on the
+ * lattice, so the number of particles on the lattice is conserved exactly.
+ *
+ * \param[out] lattices The lattices to be updated, together with the
+ *             density type to be computed on each of them
+ * \param[in] update tells if called for update at printout or at timestep
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] particles the particles vector
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool Threads computing the convolutions, nullptr to compute
+ *            them on the calling thread only
+ * \throw std::invalid_argument if the lattices do not have identical sizes,
+ *        cell numbers, origins and boundary conditions
+ */
+void update_lattices_by_convolution(
+    const std::vector<std::pair<DensityLattice *, DensityType>> &lattices,
+    const LatticeUpdate update, const DensityParameters &par,
+    const Particles &particles, const bool compute_gradient = false,
+    ThreadPool *pool = nullptr);
+
+/**
+ * Updates the contents on the lattice, see update_lattices().
+ *
+ * \param[out] lat The lattice on which the content will be updated
+ * \param[in] update tells if called for update at printout or at timestep
+ * \param[in] dens_type density type to be computed on the lattice
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] particles the particles vector
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool Threads filling the lattice, nullptr to fill it on the
+ *            calling thread only
+ * \tparam T LatticeType
+ */
+template <typename T>
+void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
+                    const DensityType dens_type, const DensityParameters &par,
+                    const Particles &particles,
+                    const bool compute_gradient = false,
+                    ThreadPool *pool = nullptr) {
+  update_lattices<T>({{lat, dens_type}}, update, par, particles,
+                     compute_gradient, pool);
 }
 
 }  // namespace smash
@@ -8,15 +8,23 @@
 #define SRC_INCLUDE_SMASH_EXPERIMENT_H_
 
 #include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "actionfinderfactory.h"
 #include "actions.h"
+#include "adaptivetimestep.h"
 #include "bremsstrahlungaction.h"
+#include "bufferedoutput.h"
 #include "chrono.h"
 #include "decayactionsfinder.h"
 #include "decayactionsfinderdilepton.h"
@@ -33,8 +41,10 @@
 #include "quantumnumbers.h"
 #include "scatteractionphoton.h"
 #include "scatteractionsfinder.h"
+#include "setup_particles_decaymodes.h"
 #include "stringprocess.h"
 #include "thermalizationaction.h"
+#include "threadpool.h"
 // Output
 #include "binaryoutput.h"
 #ifdef SMASH_USE_HEPMC
@@ -221,6 +231,14 @@ class Experiment : public ExperimentBase {
    */
   void final_output(const int evt_num);
 
+  /**
+   * Runs one complete event: initialization, time evolution, final decays and
+   * the output at event end.
+   *
+   * \param[in] event_number Number of the event
+   */
+  void run_event(int event_number);
+
   /**
    * Provides external access to SMASH particles. This is helpful if SMASH
    * is used as a 3rd-party library.
@@ -259,14 +277,37 @@ class Experiment : public ExperimentBase {
   void create_output(const std::string &format, const std::string &content,
                      const bf::path &output_path, const OutputParameters &par);
 
+  /**
+   * Run the events concurrently on \ref n_threads_ worker Experiments.
+   *
+   * Each worker owns its particles, finders, lattices and BufferedOutput
+   * objects standing in for the outputs of this Experiment. The random
+   * numbers of an event only depend on the master seed and the event number
+   * (see random::stream_seed) and the buffered events are
+   * written to the real outputs strictly in event order, so the result does
+   * not depend on the number of threads.
+   */
+  void run_parallel();
+
   /**
    * Propagate all particles until time to_time without any interactions
-   * and shine dileptons.
+   * and shine dileptons, unless the shining is accumulated.
    *
    * \param[in] to_time Time at the end of propagation [fm/c]
    */
   void propagate_and_shine(double to_time);
 
+  /**
+   * If the dilepton shining is accumulated (see \key Accumulated_Shining),
+   * shine all particles for the time since the last call and remember the
+   * current time. To be called whenever the particles have been propagated
+   * to \p time and are about to change other than by actions, or dileptons
+   * should be written.
+   *
+   * \param[in] time Current time of all particles [fm/c]
+   */
+  void shine_accumulated(double time);
+
   /**
    * Performs all the propagations and actions during a certain time interval
    * neglecting the influence of the potentials. This function is called in
@@ -278,8 +319,28 @@ class Experiment : public ExperimentBase {
    * \param[in, out] actions Actions occur during a certain time interval.
    *                 They provide the ending times of the propagations and
    *                 are updated during the time interval.
+   * \param[in, out] grid Grid that was updated at the beginning of the time
+   *                 interval, or nullptr. If given, it is kept up to date with
+   *                 the performed actions, and secondary collisions are only
+   *                 searched among the particles in the cells around the
+   *                 outgoing particles. Otherwise, all particles are searched.
+   */
+  void run_time_evolution_timestepless(
+      Actions &actions, typename Modus::GridType *grid = nullptr);
+
+  /**
+   * Finds the actions of the current time step on the threads of \ref
+   * thread_pool_, see \key Threads_Per_Event. The actions are collected per
+   * search cell and inserted in the order of the cells, as in a serial
+   * search.
+   *
+   * \param[in] grid Grid of the current time step.
+   * \param[in] dt Duration of the time step [fm/c].
+   * \param[in, out] actions The found actions are inserted here.
    */
-  void run_time_evolution_timestepless(Actions &actions);
+  template <GridOptions Options>
+  void find_actions_in_parallel(const Grid<Options> &grid, double dt,
+                                Actions &actions);
 
   /// Intermediate output during an event
   void intermediate_output();
@@ -304,6 +365,25 @@ class Experiment : public ExperimentBase {
     return parameters_.outputclock->next_time();
   }
 
+  /**
+   * Independent copy of the configuration from which the worker Experiments
+   * are created if events run concurrently, nullptr otherwise.
+   */
+  std::unique_ptr<Configuration> worker_config_;
+
+  /// Number of threads running events concurrently.
+  const int n_threads_;
+
+  /// Number of threads searching for actions within one event.
+  const int threads_per_event_;
+
+  /**
+   * The \ref threads_per_event_ threads that search for actions and fill the
+   * density lattices at every time step, nullptr if the event runs on one
+   * thread only.
+   */
+  std::unique_ptr<ThreadPool> thread_pool_;
+
   /**
    * Struct of several member variables.
    * These variables are combined into a struct for efficient input to functions
@@ -368,9 +448,25 @@ class Experiment : public ExperimentBase {
   /// The Action finder objects
   std::vector<std::unique_ptr<ActionFinderInterface>> action_finders_;
 
+  /**
+   * The decay finder if decays are scheduled event by event (see
+   * \key Event_Driven_Decays), nullptr otherwise. It is not part of
+   * action_finders_, because it is not run on the grid in every time step.
+   */
+  std::unique_ptr<DecayActionsFinder> decay_finder_;
+
   /// The Dilepton Action Finder
   std::unique_ptr<DecayActionsFinderDilepton> dilepton_finder_;
 
+  /**
+   * Whether dileptons are shone for whole lifetime segments of the particles
+   * instead of at every propagation, see \key Accumulated_Shining.
+   */
+  bool accumulated_shining_ = false;
+
+  /// Time up to which all particles were shone in accumulated shining [fm/c]
+  double shining_time_ = 0.;
+
   /// The (Scatter) Actions Finder for Direct Photons
   std::unique_ptr<ActionFinderInterface> photon_finder_;
 
@@ -383,6 +479,12 @@ class Experiment : public ExperimentBase {
   /// Isospin projection density on the lattices
   std::unique_ptr<DensityLattice> jmu_I3_lat_;
 
+  /**
+   * Whether the densities for the potentials are computed by a convolution,
+   * see \key Smearing_By_Convolution
+   */
+  bool smearing_by_convolution_ = false;
+
   /**
    * Custom density on the lattices.
    * In the config user asks for some kind of density for printout.
@@ -455,6 +557,9 @@ class Experiment : public ExperimentBase {
    */
   const int nevents_;
 
+  /// Number of the first event, see \key First_Event.
+  const int first_event_;
+
   /// simulation time at which the evolution is stopped.
   const double end_time_;
 
@@ -474,6 +579,12 @@ class Experiment : public ExperimentBase {
   /// This indicates whether to use the grid.
   const bool use_grid_;
 
+  /**
+   * The grid for finding actions. It is kept between time steps and events and
+   * updated at the beginning of each time step.
+   */
+  std::unique_ptr<typename Modus::GridType> grid_;
+
   /// This struct contains information on the metric to be used
   const ExpansionProperties metric_;
 
@@ -492,6 +603,9 @@ class Experiment : public ExperimentBase {
   /// This indicates whether to use time steps.
   const TimeStepMode time_step_mode_;
 
+  /// Chooses the time steps in the adaptive time step mode, nullptr otherwise
+  std::unique_ptr<AdaptiveTimeStep> adaptive_time_step_;
+
   /// Maximal distance at which particles can interact, squared
   double max_transverse_distance_sqr_ = std::numeric_limits<double>::max();
 
@@ -564,7 +678,10 @@ class Experiment : public ExperimentBase {
    */
   double total_energy_removed_ = 0.0;
 
-  /// random seed for the next event.
+  /**
+   * Master random seed. The engine of every event is seeded with
+   * random::stream_seed(seed_, event number).
+   */
   int64_t seed_ = -1;
 
   /**
@@ -657,6 +774,19 @@ void Experiment<Modus>::create_output(const std::string &format,
  */
 ExperimentParameters create_experiment_parameters(Configuration config);
 
+/**
+ * Copies the configuration for the worker Experiments of a multi-threaded
+ * run, see \key Threads in \ref input_general_. The \key Threads value is
+ * removed from the copy, so that the workers run their events serially.
+ *
+ * \param[in] config The configuration of the main Experiment. It is not
+ *            modified.
+ * \return The worker configuration, or nullptr if the events are run on a
+ *         single thread.
+ */
+std::unique_ptr<Configuration> create_worker_configuration(
+    Configuration config);
+
 /*!\Userguide
  * \page input_general_
  * \key End_Time (double, required): \n
@@ -664,12 +794,43 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * that the starting time depends on the chosen Modus.
  *
  * \key Randomseed (int, required): \n
- * Initial seed for the random number generator. If this is
+ * Master seed for the random number generator. If this is
  * negative, the seed will be randomly generated by the operating system.
+ * Every event has its own random number stream, whose seed is derived from
+ * the master seed and the event number only. An event can therefore be
+ * reproduced on its own by running it with the same \key Randomseed and
+ * \key First_Event set to its event number.
  *
  * \key Nevents (int, required): \n
  * Number of events to calculate.
  *
+ * \key First_Event (int, optional, default = 0): \n
+ * Number of the first event. The events are numbered from \key First_Event
+ * to \key First_Event + \key Nevents - 1.
+ *
+ * \key Threads (int, optional, default = 1): \n
+ * Number of threads on which independent events are calculated concurrently.
+ * Each thread holds its own copy of the particles, lattices and finders. The
+ * events are written to the output files in the order of their event number.
+ * Every event seeds its random number engine with the stream seed of its
+ * event number (see above), whichever thread calculates it, so the output
+ * does not depend on the number of threads or on the order in which the
+ * events finish. Not supported for the List modus and together with forced
+ * thermalization.
+ *
+ * \key Threads_Per_Event (int, optional, default = 1): \n
+ * Number of threads on which the actions of one event are searched at the
+ * beginning of every time step. The cells of the collision-finding grid are
+ * distributed over the threads. If this is larger than 1, every grid cell
+ * draws its random numbers from its own stream, derived from the event's
+ * stream and the cell index. The results then do not depend on the number of
+ * threads, but differ from those of a run with a single thread per event.
+ * With potentials, the density lattices are also filled on this many
+ * threads. This does not change the densities at all, every lattice node sums
+ * up the contributions of the particles in the same order as in a serial run.
+ * Can be combined with \key Threads, which then uses
+ * \key Threads × \key Threads_Per_Event threads in total.
+ *
  * \key Use_Grid (bool, optional, default = true): \n
  * \li \key true - A grid is used to reduce the combinatorics of interaction
  * lookup \n \li \key false - No grid is used.
@@ -681,6 +842,27 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * \li \key Fixed - Fixed-sized time steps at which collision-finding grid is
  * created.  More efficient for systems with many particles. The Delta_Time is
  * provided by user.\n
+ * \li \key Adaptive - Like Fixed, but Delta_Time is only the first time step.
+ * The following ones are shrunk if the potentials or the interaction rate
+ * require it and grow while the system becomes dilute, see
+ * \key Adaptive_Time_Step. \n
+ *
+ * \key Adaptive_Time_Step (map, optional): \n
+ * Parameters of the adaptive time step mode. A time step exceeding one of the
+ * limits is shrunk right away, otherwise it grows by \key Growth_Factor per
+ * step.
+ * \li \key Min_Delta_Time (double, optional, default = Delta_Time / 10):
+ * Smallest time step [fm/c]. \n
+ * \li \key Max_Delta_Time (double, optional, default = 10 Delta_Time):
+ * Largest time step [fm/c]. \n
+ * \li \key Force_Safety_Factor (double, optional, default = 0.1): Fraction of
+ * the time scale of the momentum change due to the potentials that one time
+ * step may last. \n
+ * \li \key Max_Interactions_Per_Particle (double, optional, default = 0.1):
+ * Average number of interactions per particle that one time step may
+ * contain. \n
+ * \li \key Growth_Factor (double, optional, default = 1.25): Largest growth
+ * of the time step from one step to the next. \n
  *
  * For Delta_Time explanation see \ref input_general_.
  *
@@ -749,6 +931,17 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * (The same cross section is used as for the d' reactions, therefore the d' in
  * particles.txt and its decay in decaymodest.txt also need to be uncommented.)
  *
+ * \key Event_Driven_Decays (bool, optional, default = \key false): \n
+ * \li \key true - Sample the decay time of every resonance once, when it is
+ * created, and keep the decay in the list of actions until it happens or the
+ * resonance interacts otherwise. Resonances are only searched for decays in
+ * every time step if potentials, an expanding metric or forced thermalization
+ * may have changed them. \n
+ * \li \key false - Sample a decay time for every resonance in every time
+ * step and keep it only if it lies within the time step. \n
+ * Both are equivalent because of the exponential decay law, but their random
+ * numbers differ.
+ *
  * \key Force_Decays_At_End (bool, optional, default = \key true): \n
  * \li \key true - Force all resonances to decay after last timestep \n
  * \li \key false - Don't force decays (final output can contain resonances)
@@ -820,11 +1013,15 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  */
 template <typename Modus>
 Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
-    : parameters_(create_experiment_parameters(config)),
+    : worker_config_(create_worker_configuration(config)),
+      n_threads_(config.take({"General", "Threads"}, 1)),
+      threads_per_event_(config.take({"General", "Threads_Per_Event"}, 1)),
+      parameters_(create_experiment_parameters(config)),
       density_param_(DensityParameters(parameters_)),
       modus_(config["Modi"], parameters_),
       particles_(),
       nevents_(config.take({"General", "Nevents"})),
+      first_event_(config.take({"General", "First_Event"}, 0)),
       end_time_(config.take({"General", "End_Time"})),
       delta_time_startup_(parameters_.labclock->timestep_duration()),
       force_decays_(
@@ -844,6 +1041,47 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
           config.take({"General", "Time_Step_Mode"}, TimeStepMode::Fixed)) {
   logg[LExperiment].info() << *this;
 
+  if (n_threads_ < 1 || threads_per_event_ < 1) {
+    throw std::invalid_argument("The number of threads has to be positive.");
+  }
+  if (n_threads_ > 1 && modus_.is_list()) {
+    throw std::invalid_argument(
+        "The List modus reads the events sequentially from file and cannot "
+        "be run on several threads.");
+  }
+  if (n_threads_ > 1 && config.has_value({"Forced_Thermalization"})) {
+    throw std::invalid_argument(
+        "Forced thermalization cannot be run on several threads.");
+  }
+  // If events run concurrently, the workers calculate them with own pools.
+  if (threads_per_event_ > 1 && n_threads_ == 1) {
+    thread_pool_ = make_unique<ThreadPool>(threads_per_event_);
+  }
+
+  density_param_.tabulate_kernel(
+      config.take({"General", "Gauss_Kernel_Tolerance"}, 0.));
+
+  /* Build everything of the particle and decay mode data that is otherwise
+   * initialized on first use. It is then only read during the events, which
+   * concurrent events and action finders rely on. The tables do not depend on
+   * the events run before, such that serial and parallel runs agree. */
+  initialize_physics_tables();
+
+  if (time_step_mode_ == TimeStepMode::Adaptive) {
+    adaptive_time_step_ = make_unique<AdaptiveTimeStep>(
+        config.take({"General", "Adaptive_Time_Step", "Min_Delta_Time"},
+                    0.1 * delta_time_startup_),
+        config.take({"General", "Adaptive_Time_Step", "Max_Delta_Time"},
+                    10. * delta_time_startup_),
+        config.take({"General", "Adaptive_Time_Step", "Force_Safety_Factor"},
+                    0.1),
+        config.take(
+            {"General", "Adaptive_Time_Step", "Max_Interactions_Per_Particle"},
+            0.1),
+        config.take({"General", "Adaptive_Time_Step", "Growth_Factor"},
+                    1.25));
+  }
+
   if (parameters_.coll_crit == CollisionCriterion::Stochastic &&
       time_step_mode_ != TimeStepMode::Fixed) {
     throw std::invalid_argument(
@@ -852,6 +1090,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
   }
 
   // create finders
+  accumulated_shining_ = config.take(
+      {"Collision_Term", "Dileptons", "Accumulated_Shining"}, false);
   if (dileptons_switch_) {
     dilepton_finder_ = make_unique<DecayActionsFinderDilepton>();
   }
@@ -859,6 +1099,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     n_fractional_photons_ =
         config.take({"Collision_Term", "Photons", "Fractional_Photons"}, 100);
   }
+  const bool event_driven_decays =
+      config.take({"Collision_Term", "Event_Driven_Decays"}, false);
   if (parameters_.two_to_one) {
     if (parameters_.res_lifetime_factor < 0.) {
       throw std::invalid_argument(
@@ -871,8 +1113,13 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
           "inelastically (e.g. resonance chains), else SMASH is known to "
           "hang.");
     }
-    action_finders_.emplace_back(
-        make_unique<DecayActionsFinder>(parameters_.res_lifetime_factor));
+    if (event_driven_decays) {
+      decay_finder_ =
+          make_unique<DecayActionsFinder>(parameters_.res_lifetime_factor);
+    } else {
+      action_finders_.emplace_back(
+          make_unique<DecayActionsFinder>(parameters_.res_lifetime_factor));
+    }
   }
   bool no_coll = config.take({"Collision_Term", "No_Collisions"}, false);
   if ((parameters_.two_to_one || parameters_.included_2to2.any() ||
@@ -1269,6 +1516,15 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
    * Include potential effects, since mean field potentials change the threshold
    * energies of the actions.
    *
+   * \key Smearing_By_Convolution (bool, optional, default = false): \n
+   * Compute the densities for the potentials by assigning the particles to
+   * the nearest lattice nodes and convolving them with the gaussian, instead
+   * of smearing every particle separately. The cost then grows with the
+   * number of lattice nodes instead of the number of particles, which is
+   * much faster for many test particles. The densities are approximated:
+   * the gaussian is not Lorentz contracted and the results depend slightly
+   * on the cell size, which should be well below \key Gaussian_Sigma.
+   *
    * For information on the format of the lattice output see
    * \ref output_vtk_lattice_. To configure the
    * thermodynamic output, see \ref input_output_options_.
@@ -1299,6 +1555,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     const std::array<int, 3> n = config.take({"Lattice", "Cell_Number"});
     const std::array<double, 3> origin = config.take({"Lattice", "Origin"});
     const bool periodic = config.take({"Lattice", "Periodic"});
+    smearing_by_convolution_ =
+        config.take({"Lattice", "Smearing_By_Convolution"}, false);
 
     if (printout_lattice_td_) {
       dens_type_lattice_printout_ = output_parameters.td_dens_type;
@@ -1449,18 +1707,11 @@ EventInfo fill_event_info(const Particles &particles, double E_mean_field,
 
 template <typename Modus>
 void Experiment<Modus>::initialize_new_event(int event_number) {
-  random::set_seed(seed_);
-  logg[LExperiment].info() << "random number seed: " << seed_;
-  /* Set seed for the next event. It has to be positive, so it can be entered
-   * in the config.
-   *
-   * We have to be careful about the minimal integer, whose absolute value
-   * cannot be represented. */
-  int64_t r = random::advance();
-  while (r == INT64_MIN) {
-    r = random::advance();
-  }
-  seed_ = std::abs(r);
+  const int64_t event_seed = random::stream_seed(seed_, event_number);
+  random::set_seed(event_seed);
+  logg[LExperiment].info() << "random number seed: " << seed_ << ", event "
+                           << event_number << " (event seed " << event_seed
+                           << ")";
   /* Set the random seed used in PYTHIA hadronization
    * to be same with the SMASH one.
    * In this way we ensure that the results are reproducible
@@ -1482,6 +1733,7 @@ void Experiment<Modus>::initialize_new_event(int event_number) {
 
   switch (time_step_mode_) {
     case TimeStepMode::Fixed:
+    case TimeStepMode::Adaptive:
       break;
     case TimeStepMode::None:
       timestep = end_time_ - start_time;
@@ -1501,6 +1753,7 @@ void Experiment<Modus>::initialize_new_event(int event_number) {
   }
   clock_for_this_event = make_unique<UniformClock>(start_time, timestep);
   parameters_.labclock = std::move(clock_for_this_event);
+  shining_time_ = start_time;
 
   // Reset the output clock
   parameters_.outputclock->reset(start_time, true);
@@ -1520,6 +1773,10 @@ void Experiment<Modus>::initialize_new_event(int event_number) {
   previous_interactions_total_ = 0;
   discarded_interactions_total_ = 0;
   total_pauli_blocked_ = 0;
+  if (pauli_blocker_) {
+    // the index of the previous event refers to particles that are gone
+    pauli_blocker_->update_index(particles_, 0.);
+  }
   projectile_target_interact_ = false;
   total_hypersurface_crossing_actions_ = 0;
   total_energy_removed_ = 0.0;
@@ -1598,6 +1855,10 @@ bool Experiment<Modus>::perform_action(
    * interaction yet". */
   const auto id_process = static_cast<uint32_t>(interactions_total_ + 1);
   action.perform(&particles_, id_process);
+  if (pauli_blocker_) {
+    pauli_blocker_->update_index(action.incoming_particles(),
+                                 action.outgoing_particles());
+  }
   interactions_total_++;
   if (action.get_type() == ProcessType::Wall) {
     wall_actions_total_++;
@@ -1713,6 +1974,9 @@ bool Experiment<Modus>::perform_action(
 template <typename Modus>
 void Experiment<Modus>::run_time_evolution() {
   Actions actions;
+  /* Whether the decays have to be scheduled anew for all particles, because
+   * they changed outside of performed actions. */
+  bool reschedule_decays = true;
 
   while (parameters_.labclock->current_time() < end_time_) {
     const double t = parameters_.labclock->current_time();
@@ -1732,59 +1996,112 @@ void Experiment<Modus>::run_time_evolution() {
       ThermalizationAction th_act(*thermalizer_, current_t);
       if (th_act.any_particles_thermalized()) {
         perform_action(th_act, particles_);
+        reschedule_decays = true;
       }
     }
 
+    /* (0) Schedule the decays of all resonances. Only decays sampled in
+     *     earlier time steps can still be in the list of actions, all other
+     *     actions end within their time step. */
+    if (decay_finder_ && reschedule_decays) {
+      actions.clear();
+      actions.insert(decay_finder_->find_actions_in_cell(
+          particles_.copy_to_vector(), std::numeric_limits<double>::infinity(),
+          0., beam_momentum_));
+      reschedule_decays = false;
+    }
+
+    /* (0.a) Index the baryons for Pauli blocking. No particle moves farther
+     *       than dt within this time step. */
+    if (pauli_blocker_) {
+      pauli_blocker_->update_index(particles_, dt);
+    }
+
+    typename Modus::GridType *grid_of_step = nullptr;
     if (particles_.size() > 0 && action_finders_.size() > 0) {
-      /* (1.a) Create grid. */
+      /* (1.a) Create or update grid. */
       double min_cell_length = compute_min_cell_length(dt);
-      logg[LExperiment].debug("Creating grid with minimal cell length ",
+      logg[LExperiment].debug("Updating grid with minimal cell length ",
                               min_cell_length);
-      const auto &grid =
-          use_grid_ ? modus_.create_grid(particles_, min_cell_length, dt)
-                    : modus_.create_grid(particles_, min_cell_length, dt,
-                                         CellSizeStrategy::Largest);
+      const CellSizeStrategy strategy =
+          use_grid_ ? CellSizeStrategy::Optimal : CellSizeStrategy::Largest;
+      if (grid_) {
+        modus_.update_grid(*grid_, particles_, min_cell_length, dt, strategy);
+      } else {
+        grid_ = make_unique<typename Modus::GridType>(
+            modus_.create_grid(particles_, min_cell_length, dt, strategy));
+      }
+      grid_of_step = grid_.get();
+      const auto &grid = *grid_;
 
       const double gcell_vol = grid.cell_volume();
 
       /* (1.b) Iterate over cells and find actions. */
-      grid.iterate_cells(
-          [&](const ParticleList &search_list) {
-            for (const auto &finder : action_finders_) {
-              actions.insert(finder->find_actions_in_cell(
-                  search_list, dt, gcell_vol, beam_momentum_));
-            }
-          },
-          [&](const ParticleList &search_list,
-              const ParticleList &neighbors_list) {
-            for (const auto &finder : action_finders_) {
-              actions.insert(finder->find_actions_with_neighbors(
-                  search_list, neighbors_list, dt, beam_momentum_));
-            }
-          });
+      if (thread_pool_) {
+        find_actions_in_parallel(grid, dt, actions);
+      } else {
+        grid.iterate_cells(
+            [&](const ParticleListView &search_list) {
+              for (const auto &finder : action_finders_) {
+                actions.insert(finder->find_actions_in_cell(
+                    search_list, dt, gcell_vol, beam_momentum_));
+              }
+            },
+            [&](const ParticleListView &search_list,
+                const ParticleListView &neighbors_list) {
+              for (const auto &finder : action_finders_) {
+                actions.insert(finder->find_actions_with_neighbors(
+                    search_list, neighbors_list, dt, beam_momentum_));
+              }
+            });
+      }
     }
 
-    /* \todo (optimizations) Adapt timestep size here */
-
     /* (2) Propagation from action to action until the end of timestep */
-    run_time_evolution_timestepless(actions);
+    const uint64_t interactions_before =
+        interactions_total_ - wall_actions_total_;
+    run_time_evolution_timestepless(actions, grid_of_step);
 
     /* (3) Update potentials (if computed on the lattice) and
      *     compute new momenta according to equations of motion */
+    double force_time_scale = std::numeric_limits<double>::infinity();
     if (potentials_) {
       update_potentials();
-      update_momenta(&particles_, parameters_.labclock->timestep_duration(),
-                     *potentials_, FB_lat_.get(), FI3_lat_.get());
+      force_time_scale = update_momenta(
+          &particles_, parameters_.labclock->timestep_duration(), *potentials_,
+          FB_lat_.get(), FI3_lat_.get());
+      // the widths depend on the changed masses
+      reschedule_decays = true;
     }
 
     /* (4) Expand universe if non-minkowskian metric; updates
      *     positions and momenta according to the selected expansion */
     if (metric_.mode_ != ExpansionMode::NoExpansion) {
       expand_space_time(&particles_, parameters_, metric_);
+      reschedule_decays = true;
     }
 
     ++(*parameters_.labclock);
 
+    /* (4.a) Adapt the time step to the forces and the interaction rate. The
+     *       grid cell size follows from it in the next step, see
+     *       compute_min_cell_length. */
+    if (adaptive_time_step_) {
+      const uint64_t interactions =
+          interactions_total_ - wall_actions_total_ - interactions_before;
+      double next_dt = adaptive_time_step_->next_timestep(
+          dt, force_time_scale, interactions, particles_.size());
+      const double max_dt = modus_.max_timestep(max_transverse_distance_sqr_);
+      if (max_dt > 0. && max_dt < next_dt) {
+        next_dt = max_dt;
+      }
+      // The lab clock is always a UniformClock, see run_time_evolution init.
+      static_cast<UniformClock &>(*parameters_.labclock)
+          .set_timestep_duration(next_dt);
+      logg[LExperiment].debug("Next time step: ", next_dt, " fm/c after ",
+                              interactions, " interactions.");
+    }
+
     /* (5) Check conservation laws.
      *
      * Check conservation of conserved quantities if potentials and string
@@ -1812,13 +2129,25 @@ template <typename Modus>
 void Experiment<Modus>::propagate_and_shine(double to_time) {
   const double dt =
       propagate_straight_line(&particles_, to_time, beam_momentum_);
-  if (dilepton_finder_ != nullptr) {
+  if (dilepton_finder_ != nullptr && !accumulated_shining_) {
     for (const auto &output : outputs_) {
       dilepton_finder_->shine(particles_, output.get(), dt);
     }
   }
 }
 
+template <typename Modus>
+void Experiment<Modus>::shine_accumulated(double time) {
+  if (dilepton_finder_ == nullptr || !accumulated_shining_) {
+    return;
+  }
+  for (const auto &output : outputs_) {
+    dilepton_finder_->shine_accumulated(particles_, output.get(),
+                                        shining_time_);
+  }
+  shining_time_ = time;
+}
+
 /**
  * Make sure `interactions_total` can be represented as a 32-bit integer.
  * This is necessary for converting to a `id_process`. The latter is 32-bit
@@ -1834,7 +2163,57 @@ inline void check_interactions_total(uint64_t interactions_total) {
 }
 
 template <typename Modus>
-void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
+template <GridOptions Options>
+void Experiment<Modus>::find_actions_in_parallel(const Grid<Options> &grid,
+                                                 double dt, Actions &actions) {
+  const double gcell_vol = grid.cell_volume();
+  std::vector<ActionList> cell_actions(grid.total_number_of_cells());
+  auto append = [](ActionList &to, ActionList &&found) {
+    std::move(found.begin(), found.end(), std::back_inserter(to));
+  };
+
+  /* Every search cell draws its random numbers from its own stream, so the
+   * found actions do not depend on which thread handles which cell. The
+   * calling thread also searches cells, therefore its engine is restored
+   * afterwards. The potentials are thread-local and have to be passed on to
+   * the helper threads. */
+  const int64_t cells_seed = random::advance() >> 1;
+  const random::Engine event_engine = random::engine;
+  RectangularLattice<FourVector> *const UB_lat = UB_lat_pointer;
+  RectangularLattice<FourVector> *const UI3_lat = UI3_lat_pointer;
+  Potentials *const pot = pot_pointer;
+
+  grid.iterate_cells_parallel(
+      *thread_pool_,
+      [&](int cell, const ParticleListView &search_list) {
+        random::set_seed(random::stream_seed(cells_seed, cell));
+        UB_lat_pointer = UB_lat;
+        UI3_lat_pointer = UI3_lat;
+        pot_pointer = pot;
+        for (const auto &finder : action_finders_) {
+          append(cell_actions[cell],
+                 finder->find_actions_in_cell(search_list, dt, gcell_vol,
+                                              beam_momentum_));
+        }
+      },
+      [&](int cell, const ParticleListView &search_list,
+          const ParticleListView &neighbors_list) {
+        for (const auto &finder : action_finders_) {
+          append(cell_actions[cell],
+                 finder->find_actions_with_neighbors(
+                     search_list, neighbors_list, dt, beam_momentum_));
+        }
+      });
+  random::engine = event_engine;
+
+  for (ActionList &found : cell_actions) {
+    actions.insert(std::move(found));
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_time_evolution_timestepless(
+    Actions &actions, typename Modus::GridType *grid) {
   const double start_time = parameters_.labclock->current_time();
   const double end_time =
       std::min(parameters_.labclock->next_time(), end_time_);
@@ -1843,8 +2222,10 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
       "Timestepless propagation: ", "Actions size = ", actions.size(),
       ", start time = ", start_time, ", end time = ", end_time);
 
-  // iterate over all actions
-  while (!actions.is_empty()) {
+  ParticleList surrounding_particles;
+  /* iterate over all actions of this time interval; scheduled decays may lie
+   * beyond it and stay in the list */
+  while (!actions.is_empty() && actions.earliest_time() <= end_time) {
     // get next action
     ActionPtr act = actions.pop();
     if (!act->is_valid(particles_)) {
@@ -1853,17 +2234,13 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
                               " (discarded: invalid)");
       continue;
     }
-    if (act->time_of_execution() > end_time) {
-      logg[LExperiment].error(
-          act, " scheduled later than end time: t_action[fm/c] = ",
-          act->time_of_execution(), ", t_end[fm/c] = ", end_time);
-    }
     logg[LExperiment].debug(~einhard::Green(), "✔ ", act);
 
     while (next_output_time() <= act->time_of_execution()) {
       logg[LExperiment].debug("Propagating until output time: ",
                               next_output_time());
       propagate_and_shine(next_output_time());
+      shine_accumulated(next_output_time());
       ++(*parameters_.outputclock);
       intermediate_output();
     }
@@ -1886,20 +2263,51 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
     if (!performed) {
       continue;
     }
+    /* The destroyed particles shine for the rest of their lifetime. Particles
+     * crossing a wall live on and keep accumulating. */
+    if (dilepton_finder_ != nullptr && accumulated_shining_ &&
+        act->get_type() != ProcessType::Wall) {
+      for (const auto &output : outputs_) {
+        dilepton_finder_->shine_accumulated(act->incoming_particles(),
+                                            output.get(), shining_time_);
+      }
+    }
 
-    /* (3) Update actions for newly-produced particles. */
+    /* (3) Remove the actions of the incoming particles that became invalid
+     * and update actions for newly-produced particles. */
+    discarded_interactions_total_ +=
+        actions.remove_invalid(act->incoming_particles(), particles_);
 
     time_left = end_time - act->time_of_execution();
     const ParticleList &outgoing_particles = act->outgoing_particles();
+    if (grid) {
+      grid->replace(act->incoming_particles(), outgoing_particles);
+      grid->surrounding_particles(outgoing_particles, particles_,
+                                  surrounding_particles);
+    }
     // Grid cell volume set to zero, since there is no grid
     const double gcell_vol = 0.0;
+    if (decay_finder_ && act->get_type() != ProcessType::Wall) {
+      /* The decays of new resonances are scheduled right away. A particle
+       * crossing a wall keeps its id and history, so its scheduled decay
+       * stays valid. */
+      actions.insert(decay_finder_->find_actions_in_cell(
+          outgoing_particles, std::numeric_limits<double>::infinity(),
+          gcell_vol, beam_momentum_));
+    }
     for (const auto &finder : action_finders_) {
       // Outgoing particles can still decay, cross walls...
       actions.insert(finder->find_actions_in_cell(outgoing_particles, time_left,
                                                   gcell_vol, beam_momentum_));
       // ... and collide with other particles.
-      actions.insert(finder->find_actions_with_surrounding_particles(
-          outgoing_particles, particles_, time_left, beam_momentum_));
+      if (grid) {
+        actions.insert(finder->find_actions_with_neighbors(
+            outgoing_particles, surrounding_particles, time_left,
+            beam_momentum_));
+      } else {
+        actions.insert(finder->find_actions_with_surrounding_particles(
+            outgoing_particles, particles_, time_left, beam_momentum_));
+      }
     }
 
     check_interactions_total(interactions_total_);
@@ -1909,6 +2317,7 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
     logg[LExperiment].debug("Propagating until output time: ",
                             next_output_time());
     propagate_and_shine(next_output_time());
+    shine_accumulated(next_output_time());
     ++(*parameters_.outputclock);
     // Avoid duplicating printout at event end time
     if (parameters_.outputclock->current_time() < end_time_) {
@@ -1917,6 +2326,8 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
   }
   logg[LExperiment].debug("Propagating to time ", end_time);
   propagate_and_shine(end_time);
+  // the momenta may change in between the time steps
+  shine_accumulated(end_time);
 }
 
 template <typename Modus>
@@ -1976,6 +2387,9 @@ void Experiment<Modus>::intermediate_output() {
   // save evolution data
   if (!(modus_.is_box() && parameters_.outputclock->current_time() <
                                modus_.equilibration_time())) {
+    /* The lattices are the same for all outputs, so they are only updated
+     * for the first one. */
+    bool lattices_updated = false;
     for (const auto &output : outputs_) {
       if (output->is_dilepton_output() || output->is_photon_output() ||
           output->is_IC_output()) {
@@ -1988,15 +2402,19 @@ void Experiment<Modus>::intermediate_output() {
       // Thermodynamic output on the lattice versus time
       switch (dens_type_lattice_printout_) {
         case DensityType::Baryon:
-          update_lattice(jmu_B_lat_.get(), lat_upd, DensityType::Baryon,
-                         density_param_, particles_, false);
+          if (!lattices_updated) {
+            update_lattice(jmu_B_lat_.get(), lat_upd, DensityType::Baryon,
+                           density_param_, particles_, false);
+          }
           output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                         DensityType::Baryon, *jmu_B_lat_);
           break;
         case DensityType::BaryonicIsospin:
-          update_lattice(jmu_I3_lat_.get(), lat_upd,
-                         DensityType::BaryonicIsospin, density_param_,
-                         particles_, false);
+          if (!lattices_updated) {
+            update_lattice(jmu_I3_lat_.get(), lat_upd,
+                           DensityType::BaryonicIsospin, density_param_,
+                           particles_, false);
+          }
           output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                         DensityType::BaryonicIsospin,
                                         *jmu_I3_lat_);
@@ -2004,16 +2422,20 @@ void Experiment<Modus>::intermediate_output() {
         case DensityType::None:
           break;
         default:
-          update_lattice(jmu_custom_lat_.get(), lat_upd,
-                         dens_type_lattice_printout_, density_param_,
-                         particles_, false);
+          if (!lattices_updated) {
+            update_lattice(jmu_custom_lat_.get(), lat_upd,
+                           dens_type_lattice_printout_, density_param_,
+                           particles_, false);
+          }
           output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                         dens_type_lattice_printout_,
                                         *jmu_custom_lat_);
       }
       if (printout_tmn_ || printout_tmn_landau_ || printout_v_landau_) {
-        update_lattice(Tmn_.get(), lat_upd, dens_type_lattice_printout_,
-                       density_param_, particles_);
+        if (!lattices_updated) {
+          update_lattice(Tmn_.get(), lat_upd, dens_type_lattice_printout_,
+                         density_param_, particles_);
+        }
         if (printout_tmn_) {
           output->thermodynamics_output(ThermodynamicQuantity::Tmn,
                                         dens_type_lattice_printout_, *Tmn_);
@@ -2031,6 +2453,7 @@ void Experiment<Modus>::intermediate_output() {
       if (thermalizer_) {
         output->thermodynamics_output(*thermalizer_);
       }
+      lattices_updated = true;
     }
   }
 }
@@ -2038,43 +2461,75 @@ void Experiment<Modus>::intermediate_output() {
 template <typename Modus>
 void Experiment<Modus>::update_potentials() {
   if (potentials_) {
+    // Both densities are smeared in a single pass over the particles
+    std::vector<std::pair<DensityLattice *, DensityType>> lattices;
     if (potentials_->use_symmetry() && jmu_I3_lat_ != nullptr) {
-      update_lattice(jmu_I3_lat_.get(), LatticeUpdate::EveryTimestep,
-                     DensityType::BaryonicIsospin, density_param_, particles_,
-                     true);
+      lattices.emplace_back(jmu_I3_lat_.get(), DensityType::BaryonicIsospin);
     }
     if ((potentials_->use_skyrme() || potentials_->use_symmetry()) &&
         jmu_B_lat_ != nullptr) {
-      update_lattice(jmu_B_lat_.get(), LatticeUpdate::EveryTimestep,
-                     DensityType::Baryon, density_param_, particles_, true);
+      lattices.emplace_back(jmu_B_lat_.get(), DensityType::Baryon);
+    }
+    if (smearing_by_convolution_) {
+      update_lattices_by_convolution(lattices, LatticeUpdate::EveryTimestep,
+                                     density_param_, particles_, true,
+                                     thread_pool_.get());
+    } else {
+      update_lattices(lattices, LatticeUpdate::EveryTimestep, density_param_,
+                      particles_, true, thread_pool_.get());
+    }
+    if ((potentials_->use_skyrme() || potentials_->use_symmetry()) &&
+        jmu_B_lat_ != nullptr) {
+      /* The potentials vanish where the densities do, so only the nodes in
+       * the active tiles of the density lattices have to be evaluated. The
+       * others are reset to zero. */
+      UB_lat_->reset();
+      FB_lat_->reset();
+      if (potentials_->use_symmetry() && jmu_I3_lat_ != nullptr) {
+        UI3_lat_->reset();
+        FI3_lat_->reset();
+      }
+      const size_t tile_size = DensityLattice::tile_size;
       const size_t UBlattice_size = UB_lat_->size();
-      for (size_t i = 0; i < UBlattice_size; i++) {
-        auto jB = (*jmu_B_lat_)[i];
-        const FourVector flow_four_velocity_B =
-            std::abs(jB.density()) > really_small ? jB.jmu_net() / jB.density()
-                                                  : FourVector();
-        double baryon_density = jB.density();
-        ThreeVector baryon_grad_rho = jB.grad_rho();
-        ThreeVector baryon_dj_dt = jB.dj_dt();
-        ThreeVector baryon_rot_j = jB.rot_j();
-        if (potentials_->use_skyrme()) {
-          (*UB_lat_)[i] =
-              flow_four_velocity_B * potentials_->skyrme_pot(baryon_density);
-          (*FB_lat_)[i] = potentials_->skyrme_force(
-              baryon_density, baryon_grad_rho, baryon_dj_dt, baryon_rot_j);
+      // read only, so the tiles of the current lattices are not activated
+      const DensityLattice &jmu_B = *jmu_B_lat_;
+      const DensityLattice *jmu_I3 = jmu_I3_lat_.get();
+      for (size_t tile = 0; tile < jmu_B_lat_->number_of_tiles(); tile++) {
+        if (!jmu_B_lat_->is_active_tile(tile) &&
+            !(jmu_I3_lat_ != nullptr && jmu_I3_lat_->is_active_tile(tile))) {
+          continue;
         }
-        if (potentials_->use_symmetry() && jmu_I3_lat_ != nullptr) {
-          auto jI3 = (*jmu_I3_lat_)[i];
-          const FourVector flow_four_velocity_I3 =
-              std::abs(jI3.density()) > really_small
-                  ? jI3.jmu_net() / jI3.density()
+        const size_t tile_end =
+            std::min(UBlattice_size, (tile + 1) * tile_size);
+        for (size_t i = tile * tile_size; i < tile_end; i++) {
+          const DensityOnLattice &jB = jmu_B[i];
+          const FourVector flow_four_velocity_B =
+              std::abs(jB.density()) > really_small
+                  ? jB.jmu_net() / jB.density()
                   : FourVector();
-          (*UI3_lat_)[i] =
-              flow_four_velocity_I3 *
-              potentials_->symmetry_pot(jI3.density(), baryon_density);
-          (*FI3_lat_)[i] = potentials_->symmetry_force(
-              jI3.density(), jI3.grad_rho(), jI3.dj_dt(), jI3.rot_j(),
-              baryon_density, baryon_grad_rho, baryon_dj_dt, baryon_rot_j);
+          double baryon_density = jB.density();
+          ThreeVector baryon_grad_rho = jB.grad_rho();
+          ThreeVector baryon_dj_dt = jB.dj_dt();
+          ThreeVector baryon_rot_j = jB.rot_j();
+          if (potentials_->use_skyrme()) {
+            (*UB_lat_)[i] =
+                flow_four_velocity_B * potentials_->skyrme_pot(baryon_density);
+            (*FB_lat_)[i] = potentials_->skyrme_force(
+                baryon_density, baryon_grad_rho, baryon_dj_dt, baryon_rot_j);
+          }
+          if (potentials_->use_symmetry() && jmu_I3_lat_ != nullptr) {
+            const DensityOnLattice &jI3 = (*jmu_I3)[i];
+            const FourVector flow_four_velocity_I3 =
+                std::abs(jI3.density()) > really_small
+                    ? jI3.jmu_net() / jI3.density()
+                    : FourVector();
+            (*UI3_lat_)[i] =
+                flow_four_velocity_I3 *
+                potentials_->symmetry_pot(jI3.density(), baryon_density);
+            (*FI3_lat_)[i] = potentials_->symmetry_force(
+                jI3.density(), jI3.grad_rho(), jI3.dj_dt(), jI3.rot_j(),
+                baryon_density, baryon_grad_rho, baryon_dj_dt, baryon_rot_j);
+          }
         }
       }
     }
@@ -2102,6 +2557,9 @@ void Experiment<Modus>::do_final_decays() {
     for (const auto &finder : action_finders_) {
       actions.insert(finder->find_final_actions(particles_));
     }
+    if (decay_finder_) {
+      actions.insert(decay_finder_->find_final_actions(particles_));
+    }
     // Perform actions.
     while (!actions.is_empty()) {
       perform_action(*actions.pop(), particles_before_actions);
@@ -2218,49 +2676,163 @@ void Experiment<Modus>::final_output(const int evt_num) {
 }
 
 template <typename Modus>
-void Experiment<Modus>::run() {
-  const auto &mainlog = logg[LMain];
-  for (int j = 0; j < nevents_; j++) {
-    mainlog.info() << "Event " << j;
+void Experiment<Modus>::run_event(int event_number) {
+  // Sample initial particles, start clock, some printout and book-keeping
+  initialize_new_event(event_number);
+  /* In the ColliderModus, if the first collisions within the same nucleus are
+   * forbidden, 'nucleon_has_interacted_', which records whether a nucleon has
+   * collided with another nucleon, is initialized equal to false. If allowed,
+   * 'nucleon_has_interacted' is initialized equal to true, which means these
+   * incoming particles have experienced some fake scatterings, they can
+   * therefore collide with each other later on since these collisions are not
+   * "first" to them. */
+  if (modus_.is_collider()) {
+    if (!modus_.cll_in_nucleus()) {
+      nucleon_has_interacted_.assign(modus_.total_N_number(), false);
+    } else {
+      nucleon_has_interacted_.assign(modus_.total_N_number(), true);
+    }
+  }
+  /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
+   * to the nucleons in both the projectile and the target. */
+  if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
+    for (int i = 0; i < modus_.total_N_number(); i++) {
+      const auto mass_beam = particles_.copy_to_vector()[i].effective_mass();
+      const auto v_beam = i < modus_.proj_N_number()
+                              ? modus_.velocity_projectile()
+                              : modus_.velocity_target();
+      const auto gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
+      beam_momentum_.emplace_back(FourVector(gamma * mass_beam, 0.0, 0.0,
+                                             gamma * v_beam * mass_beam));
+    }
+  }
 
-    // Sample initial particles, start clock, some printout and book-keeping
-    initialize_new_event(j);
-    /* In the ColliderModus, if the first collisions within the same nucleus are
-     * forbidden, 'nucleon_has_interacted_', which records whether a nucleon has
-     * collided with another nucleon, is initialized equal to false. If allowed,
-     * 'nucleon_has_interacted' is initialized equal to true, which means these
-     * incoming particles have experienced some fake scatterings, they can
-     * therefore collide with each other later on since these collisions are not
-     * "first" to them. */
-    if (modus_.is_collider()) {
-      if (!modus_.cll_in_nucleus()) {
-        nucleon_has_interacted_.assign(modus_.total_N_number(), false);
-      } else {
-        nucleon_has_interacted_.assign(modus_.total_N_number(), true);
+  run_time_evolution();
+
+  if (force_decays_) {
+    do_final_decays();
+  }
+
+  // Output at event end
+  final_output(event_number);
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_parallel() {
+  /* The workers share the particle and decay mode data, which is complete
+   * since the constructor. */
+  std::vector<std::unique_ptr<Experiment<Modus>>> workers;
+  for (int i = 0; i < n_threads_; i++) {
+    workers.emplace_back(
+        make_unique<Experiment<Modus>>(worker_config_->clone(), ""));
+  }
+
+  /* Events are handed out in increasing order, and at most max_pending
+   * events are ahead of the output to bound the memory of the buffers. */
+  const int max_pending = 2 * n_threads_;
+  std::mutex mutex;
+  std::condition_variable cv;
+  const int end_event = first_event_ + nevents_;
+  int next_event = first_event_;
+  int next_output = first_event_;
+  std::map<int, OutputsList> finished_events;
+  std::exception_ptr failure;
+
+  auto run_worker = [&](Experiment<Modus> *worker) {
+    try {
+      if (worker->parameters_.potential_affect_threshold) {
+        UB_lat_pointer = worker->UB_lat_.get();
+        UI3_lat_pointer = worker->UI3_lat_.get();
+        pot_pointer = worker->potentials_.get();
       }
-    }
-    /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
-     * to the nucleons in both the projectile and the target. */
-    if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
-      for (int i = 0; i < modus_.total_N_number(); i++) {
-        const auto mass_beam = particles_.copy_to_vector()[i].effective_mass();
-        const auto v_beam = i < modus_.proj_N_number()
-                                ? modus_.velocity_projectile()
-                                : modus_.velocity_target();
-        const auto gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
-        beam_momentum_.emplace_back(FourVector(gamma * mass_beam, 0.0, 0.0,
-                                               gamma * v_beam * mass_beam));
+      while (true) {
+        int j;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [&] {
+            return failure || next_event < next_output + max_pending;
+          });
+          if (failure || next_event >= end_event) {
+            return;
+          }
+          j = next_event++;
+        }
+        worker->outputs_.clear();
+        for (const auto &output : outputs_) {
+          worker->outputs_.emplace_back(make_unique<BufferedOutput>(*output));
+        }
+        logg[LMain].info() << "Event " << j;
+        worker->run_event(j);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          finished_events[j] = std::move(worker->outputs_);
+        }
+        cv.notify_all();
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failure) {
+          failure = std::current_exception();
+        }
       }
+      cv.notify_all();
     }
+  };
 
-    run_time_evolution();
+  std::vector<std::thread> threads;
+  for (auto &worker : workers) {
+    threads.emplace_back(run_worker, worker.get());
+  }
 
-    if (force_decays_) {
-      do_final_decays();
+  // Write the finished events in order on this thread.
+  try {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (next_output < end_event) {
+      cv.wait(lock, [&] {
+        return failure || finished_events.count(next_output) > 0;
+      });
+      if (failure) {
+        break;
+      }
+      OutputsList buffers = std::move(finished_events[next_output]);
+      finished_events.erase(next_output);
+      lock.unlock();
+      for (size_t i = 0; i < outputs_.size(); i++) {
+        static_cast<BufferedOutput &>(*buffers[i]).replay_onto(*outputs_[i]);
+      }
+      lock.lock();
+      next_output++;
+      cv.notify_all();
     }
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!failure) {
+        failure = std::current_exception();
+      }
+    }
+    cv.notify_all();
+  }
 
-    // Output at event end
-    final_output(j);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::run() {
+  if (n_threads_ > 1) {
+    run_parallel();
+    return;
+  }
+  const auto &mainlog = logg[LMain];
+  for (int j = first_event_; j < first_event_ + nevents_; j++) {
+    mainlog.info() << "Event " << j;
+    run_event(j);
   }
 }
 
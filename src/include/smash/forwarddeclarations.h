@@ -64,12 +64,14 @@ class Configuration;
 class CrossSections;
 class DecayModes;
 class DecayType;
+class DecayWidths;
 class FourVector;
 class ThreeVector;
 class ModusDefault;
 class OutputInterface;
 class ParticleData;
 class Particles;
+class ParticleListView;
 class ParticleType;
 class ParticleTypePtr;
 class IsoParticleType;
@@ -77,6 +79,8 @@ class PdgCode;
 class DecayBranch;
 class CollisionBranch;
 class Tabulation;
+class ThreadPool;
+class InverseCdfTabulation;
 class ExperimentBase;
 struct ExperimentParameters;
 struct Nucleoncorr;
@@ -116,6 +120,8 @@ enum class TimeStepMode : char {
   None,
   /// Use fixed time step.
   Fixed,
+  /// Adapt the time step to the forces and the interaction rate.
+  Adaptive,
 };
 
 /**
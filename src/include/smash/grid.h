@@ -115,9 +115,57 @@ class Grid : public GridBase {
        double timestep_duration,
        CellSizeStrategy strategy = CellSizeStrategy::Optimal);
 
+  /**
+   * Brings the grid up to date with the current state of \p particles, such
+   * that it equals a grid newly constructed with the same arguments.
+   *
+   * If the cell layout stays the same, which is always the case for a fixed
+   * box, only the particles whose cell changed are moved, and the particles
+   * that were added to or removed from \p particles since the last update are
+   * inserted or erased. Since the cells only hold the storage indices of the
+   * particles, nothing has to be done for all other particles. Otherwise, the
+   * cells are filled anew, reusing their memory. The particles handed to
+   * iterate_cells are read from \p particles through their storage indices,
+   * so \p particles has to outlive the grid or the next update.
+   *
+   * \param[in] min_and_length A pair consisting of the three min coordinates
+   * and the three lengths.
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration duration of the timestep in fm/c
+   * \param[in] strategy The strategy for determining the cell size
+   * \return Whether the cells had to be filled anew.
+   * \throws runtime_error if your box length is smaller than the grid length.
+   */
+  bool update(const std::pair<std::array<double, 3>, std::array<double, 3>>
+                  &min_and_length,
+              const Particles &particles, double min_cell_length,
+              double timestep_duration,
+              CellSizeStrategy strategy = CellSizeStrategy::Optimal);
+
+  /**
+   * Brings the grid up to date with the current state of \p particles. The
+   * size of the grid is determined from the positions of the particles, as in
+   * the corresponding constructor.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration duration of the timestep in fm/c
+   * \param[in] strategy The strategy for determining the cell size
+   * \return Whether the cells had to be filled anew.
+   */
+  bool update(const Particles &particles, double min_cell_length,
+              double timestep_duration,
+              CellSizeStrategy strategy = CellSizeStrategy::Optimal) {
+    return update(find_min_and_length(particles), particles, min_cell_length,
+                  timestep_duration, strategy);
+  }
+
   /**
    * Iterates over all cells in the grid and calls the callback arguments with
-   * a search cell and 0 to 13 neighbor cells.
+   * a search cell and 0 to 13 neighbor cells. The cells are views of the
+   * particles passed to the last update, in their current state, so these
+   * particles must not be modified during the iteration.
    *
    * The neighbor cells are constructed like this:
    * - one cell at x+1
@@ -132,16 +180,160 @@ class Grid : public GridBase {
    *                              be adjusted to wrap around the grid.
    */
   void iterate_cells(
-      const std::function<void(const ParticleList &)> &search_cell_callback,
-      const std::function<void(const ParticleList &, const ParticleList &)>
+      const std::function<void(const ParticleListView &)> &search_cell_callback,
+      const std::function<void(const ParticleListView &,
+                               const ParticleListView &)>
           &neighbor_cell_callback) const;
 
+  /**
+   * Iterates over all cells in the grid like iterate_cells, but distributes
+   * the search cells over the threads of \p pool. The calling thread takes
+   * part in the iteration.
+   *
+   * All callbacks for one search cell are called by the same thread and in
+   * the same order as in iterate_cells. Callbacks for different search cells
+   * are called concurrently, so they must only write to data belonging to
+   * their search cell. Results that are collected per search cell and
+   * combined in the order of the cell index do not depend on the number of
+   * threads.
+   *
+   * \param[in] pool The threads that visit the cells.
+   * \param[in] search_cell_callback A callable called for/with the index and
+   *                                 the particles of every cell in the grid.
+   * \param[in] neighbor_cell_callback A callable called for/with the index of
+   *                              the search cell, the search cell and every
+   *                              adjacent cell, see iterate_cells.
+   * \throw Rethrows the first exception thrown by any of the callbacks.
+   */
+  void iterate_cells_parallel(
+      ThreadPool &pool,
+      const std::function<void(SizeType, const ParticleListView &)>
+          &search_cell_callback,
+      const std::function<void(SizeType, const ParticleListView &,
+                               const ParticleListView &)>
+          &neighbor_cell_callback) const;
+
+  /**
+   * Updates the cells after an action was performed during the time step:
+   * the particles in \p to_remove are taken off the grid and the particles in
+   * \p to_add are put into the cells containing their current positions.
+   * Positions outside of the grid are assigned to the closest cell at its
+   * edge.
+   *
+   * \param[in] to_remove Particles that are no longer in the list.
+   * \param[in] to_add Particles that were newly inserted into the list.
+   */
+  void replace(const ParticleList &to_remove, const ParticleList &to_add);
+
+  /**
+   * Collects the particles in the cells of the particles of \p search_list
+   * and in all cells adjacent to those, skipping the particles of \p
+   * search_list themselves. Since the cells are at least as large as the
+   * minimal cell length of the last update, these are all particles that can
+   * interact with \p search_list within the remaining time of that time step.
+   *
+   * \param[in] search_list Particles whose surroundings are collected.
+   * \param[in] particles The particles on the grid.
+   * \param[out] surrounding The collected particles, in the order of their
+   *                         storage in \p particles. Previous contents are
+   *                         discarded.
+   */
+  void surrounding_particles(const ParticleList &search_list,
+                             const Particles &particles,
+                             ParticleList &surrounding) const;
+
   /**
    * \return the volume of a single grid cell
    */
   double cell_volume() const { return cell_volume_; }
 
+  /// \return the total number of cells, i.e. the range of the cell indices.
+  SizeType total_number_of_cells() const { return cell_indices_.size(); }
+
  private:
+  /// How the particles are distributed over the cells.
+  enum class CellFilling : char {
+    /// Not filled yet.
+    None,
+    /// All particles are in a single cell.
+    AllInOne,
+    /// All particles that can interact are in a single cell.
+    InteractingInOne,
+    /// The particles that can interact are sorted into the cells.
+    Cells
+  };
+
+  /**
+   * Determines the number and size of the cells and how they are filled.
+   *
+   * \param[in] min_and_length A pair consisting of the three min coordinates
+   * and the three lengths.
+   * \param[in] particle_count Number of particles to be placed onto the grid.
+   * \param[in] max_interaction_length The minimal length a cell must have.
+   * \param[in] strategy The strategy for determining the cell size
+   * \throws runtime_error if your box length is smaller than the grid length.
+   */
+  void determine_layout(
+      const std::pair<std::array<double, 3>, std::array<double, 3>>
+          &min_and_length,
+      SizeType particle_count, double max_interaction_length,
+      CellSizeStrategy strategy);
+
+  /**
+   * Sorts all particles into the cells of the current layout.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] timestep_duration duration of the timestep in fm/c
+   */
+  void fill_cells(const Particles &particles, double timestep_duration);
+
+  /**
+   * Updates the cells of an unchanged layout to the current \p particles.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] timestep_duration duration of the timestep in fm/c
+   */
+  void move_particles(const Particles &particles, double timestep_duration);
+
+  /**
+   * Removes the particle at \p storage_index in Particles from its cell.
+   *
+   * \param[in] storage_index See Particles::storage_index.
+   */
+  void erase_index(unsigned storage_index);
+
+  /**
+   * Inserts the particle at \p storage_index in Particles into the cell \p
+   * cell_index, keeping the cell sorted.
+   *
+   * \param[in] cell_index Index of the cell.
+   * \param[in] storage_index See Particles::storage_index.
+   */
+  void insert_index(SizeType cell_index, unsigned storage_index);
+
+  /// \return the index of the cell that contains the position of \p p.
+  SizeType cell_index_for(const ParticleData &p) const;
+
+  /**
+   * \return the index of the cell that contains the position of \p p, or of
+   * the closest cell if \p p is outside of the grid.
+   */
+  SizeType nearest_cell_index_for(const ParticleData &p) const;
+
+  /**
+   * Calls the callbacks of iterate_cells for a single search cell.
+   *
+   * \param[in] search_cell_index Index of the search cell.
+   * \param[in] search_cell_callback See iterate_cells.
+   * \param[in] neighbor_cell_callback See iterate_cells.
+   */
+  void iterate_cell(
+      SizeType search_cell_index,
+      const std::function<void(const ParticleListView &)> &search_cell_callback,
+      const std::function<void(const ParticleListView &,
+                               const ParticleListView &)>
+          &neighbor_cell_callback) const;
+
   /**
    * \return the one-dimensional cell-index from the 3-dim index \p x, \p y, \p
    * z.
@@ -156,17 +348,42 @@ class Grid : public GridBase {
     return make_index(idx[0], idx[1], idx[2]);
   }
 
+  /// The minimal x, y and z coordinates of the grid.
+  std::array<double, 3> min_position_ = {{0., 0., 0.}};
+
   /// The 3 lengths of the complete grid. Used for periodic boundary wrapping.
-  const std::array<double, 3> length_;
+  std::array<double, 3> length_ = {{0., 0., 0.}};
+
+  /// The inverse cell lengths in x, y, and z direction.
+  std::array<double, 3> index_factor_ = {{0., 0., 0.}};
+
+  /// How the particles are distributed over the cells.
+  CellFilling filling_ = CellFilling::None;
 
   /// The volume of a single cell.
-  double cell_volume_;
+  double cell_volume_ = 0.;
 
   /// The number of cells in x, y, and z direction.
-  std::array<int, 3> number_of_cells_;
+  std::array<int, 3> number_of_cells_ = {{0, 0, 0}};
+
+  /**
+   * The storage indices (see Particles::storage_index) of the particles in
+   * each cell, in increasing order. This is the persistent part of the grid,
+   * which is updated incrementally.
+   */
+  std::vector<std::vector<unsigned>> cell_indices_;
+
+  /**
+   * The cell of each particle, indexed by its storage index in Particles.
+   * -1 if the particle is not on the grid.
+   */
+  std::vector<SizeType> cell_of_;
+
+  /// The particles of the last update, which the cells are views of.
+  const Particles *particles_ = nullptr;
 
-  /// The cell storage.
-  std::vector<ParticleList> cells_;
+  /// Scratch space of move_particles for the storage indices visited.
+  std::vector<bool> visited_;
 };
 
 }  // namespace smash
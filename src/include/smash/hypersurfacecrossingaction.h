@@ -77,12 +77,12 @@ class HyperSurfaceCrossActionsFinder : public ActionFinderInterface {
    * wall crossings.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &plist, double dt, const double,
+      const ParticleListView &plist, double dt, const double,
       const std::vector<FourVector> &beam_momentum) const override;
 
   /// Ignore the neighbor searches for hypersurface crossing
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, double,
+      const ParticleListView &, const ParticleListView &, double,
       const std::vector<FourVector> &) const override {
     return {};
   }
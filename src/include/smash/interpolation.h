@@ -285,8 +285,6 @@ class InterpolateDataSpline {
   double first_y_;
   /// Last y value.
   double last_y_;
-  /// GSL iterator for interpolation lookups.
-  gsl_interp_accel* acc_;
   /// GSL spline.
   gsl_spline* spline_;
 };
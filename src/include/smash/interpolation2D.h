@@ -57,10 +57,6 @@ class InterpolateData2DSpline {
   /// Last y value.
   double last_y_;
 
-  /// GSL iterator for interpolation lookups in x direction.
-  gsl_interp_accel* xacc_;
-  /// GSL iterator for interpolation lookupin y direction.
-  gsl_interp_accel* yacc_;
   /// GSL spline in 2D.
   gsl_spline2d* spline_;
 };
@@ -10,7 +10,9 @@
 #ifndef SRC_INCLUDE_SMASH_LATTICE_H_
 #define SRC_INCLUDE_SMASH_LATTICE_H_
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <utility>
@@ -41,6 +43,14 @@ enum class LatticeUpdate {
 
 /**
  * A container class to hold all the arrays on the lattice and access them.
+ *
+ * The nodes are grouped into tiles of tile_size consecutive nodes. The
+ * lattice keeps track of the tiles whose nodes might have been changed since
+ * the last reset(), i.e. those that were handed out as non-const references.
+ * Only these are reset, and is_active_tile() allows to skip the others. In
+ * collider runs, most of a large lattice stays empty, so this saves most of
+ * the work of resetting and evaluating it.
+ *
  * \tparam T The type of the contained values.
  */
 template <typename T>
@@ -72,7 +82,10 @@ class RectangularLattice {
         cell_sizes_{l[0] / n[0], l[1] / n[1], l[2] / n[2]},
         origin_(orig),
         periodic_(per),
-        when_update_(upd) {
+        when_update_(upd),
+        active_tiles_((static_cast<std::size_t>(n[0]) * n[1] * n[2] +
+                       tile_size - 1) /
+                      tile_size) {
     lattice_.resize(n_cells_[0] * n_cells_[1] * n_cells_[2]);
     logg[LLattice].debug(
         "Rectangular lattice created: sizes[fm] = (", lattice_sizes_[0], ",",
@@ -96,10 +109,43 @@ class RectangularLattice {
         cell_sizes_(rl.cell_sizes_),
         origin_(rl.origin_),
         periodic_(rl.periodic_),
-        when_update_(rl.when_update_) {}
+        when_update_(rl.when_update_),
+        active_tiles_(rl.active_tiles_.size()) {
+    for (std::size_t tile = 0; tile < active_tiles_.size(); tile++) {
+      active_tiles_[tile] = rl.is_active_tile(tile);
+    }
+  }
+
+  /// Number of nodes in one tile, see is_active_tile().
+  static constexpr std::size_t tile_size = 256;
 
   /// Sets all values on lattice to zeros.
-  void reset() { std::fill(lattice_.begin(), lattice_.end(), T()); }
+  void reset() {
+    for (std::size_t tile = 0; tile < active_tiles_.size(); tile++) {
+      if (!is_active_tile(tile)) {
+        continue;
+      }
+      const auto first = lattice_.begin() + tile * tile_size;
+      const auto last =
+          lattice_.begin() + std::min(lattice_.size(), (tile + 1) * tile_size);
+      std::fill(first, last, T());
+      active_tiles_[tile].store(false, std::memory_order_relaxed);
+    }
+  }
+
+  /// \return Number of tiles, see is_active_tile().
+  std::size_t number_of_tiles() const { return active_tiles_.size(); }
+
+  /**
+   * \return Whether the nodes with indices [tile * tile_size,
+   *         (tile + 1) * tile_size) might have been changed since the last
+   *         reset(). If not, they all hold the default value T().
+   *
+   * \param[in] tile Index of the tile.
+   */
+  bool is_active_tile(std::size_t tile) const {
+    return active_tiles_[tile].load(std::memory_order_relaxed);
+  }
 
   /**
    * Checks if 3D index is out of lattice bounds.
@@ -170,16 +216,25 @@ class RectangularLattice {
   using iterator = typename std::vector<T>::iterator;
   /// Const interator of lattice.
   using const_iterator = typename std::vector<T>::const_iterator;
-  /// \return First element of lattice.
-  iterator begin() { return lattice_.begin(); }
+  /// \return First element of lattice; marks all tiles as active.
+  iterator begin() {
+    activate_all_tiles();
+    return lattice_.begin();
+  }
   /// \return First element of lattice (const).
   const_iterator begin() const { return lattice_.begin(); }
-  /// \return Last element of lattice.
-  iterator end() { return lattice_.end(); }
+  /// \return Last element of lattice; marks all tiles as active.
+  iterator end() {
+    activate_all_tiles();
+    return lattice_.end();
+  }
   /// \return Last element of lattice (const).
   const_iterator end() const { return lattice_.end(); }
-  /// \return ith element of lattice.
-  T& operator[](std::size_t i) { return lattice_[i]; }
+  /// \return ith element of lattice; marks its tile as active.
+  T& operator[](std::size_t i) {
+    activate(i);
+    return lattice_[i];
+  }
   /// \return ith element of lattice (const).
   const T& operator[](std::size_t i) const { return lattice_[i]; }
   /// \return Size of lattice.
@@ -194,12 +249,14 @@ class RectangularLattice {
    * \return Physical quantity evaluated at the cell center.
    */
   T& node(int ix, int iy, int iz) {
-    return periodic_
-               ? lattice_[positive_modulo(ix, n_cells_[0]) +
-                          n_cells_[0] *
-                              (positive_modulo(iy, n_cells_[1]) +
-                               n_cells_[1] * positive_modulo(iz, n_cells_[2]))]
-               : lattice_[ix + n_cells_[0] * (iy + n_cells_[1] * iz)];
+    const std::size_t index =
+        periodic_ ? positive_modulo(ix, n_cells_[0]) +
+                        n_cells_[0] *
+                            (positive_modulo(iy, n_cells_[1]) +
+                             n_cells_[1] * positive_modulo(iz, n_cells_[2]))
+                  : ix + n_cells_[0] * (iy + n_cells_[1] * iz);
+    activate(index);
+    return lattice_[index];
   }
 
   /**
@@ -255,6 +312,7 @@ class RectangularLattice {
               n_cells_[0] * (positive_modulo(iy, n_cells_[1]) + z_offset);
           for (int ix = lower_bounds[0]; ix < upper_bounds[0]; ix++) {
             const int index = positive_modulo(ix, n_cells_[0]) + y_offset;
+            activate(index);
             func(lattice_[index], ix, iy, iz);
           }
         }
@@ -265,6 +323,7 @@ class RectangularLattice {
         for (int iy = lower_bounds[1]; iy < upper_bounds[1]; iy++) {
           const int y_offset = n_cells_[0] * (iy + z_offset);
           for (int ix = lower_bounds[0]; ix < upper_bounds[0]; ix++) {
+            activate(ix + y_offset);
             func(lattice_[ix + y_offset], ix, iy, iz);
           }
         }
@@ -288,31 +347,51 @@ class RectangularLattice {
   void iterate_in_radius(const ThreeVector& point, const double r_cut,
                          F&& func) {
     std::array<int, 3> l_bounds, u_bounds;
-
-    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
-     * where i is index in any direction. Therefore we want cells with condition
-     * (r-r_cut)*csize - 0.5 < i < (r+r_cut)*csize - 0.5, r = r_center - r_0 */
-    for (int i = 0; i < 3; i++) {
-      l_bounds[i] =
-          std::ceil((point[i] - origin_[i] - r_cut) / cell_sizes_[i] - 0.5);
-      u_bounds[i] =
-          std::ceil((point[i] - origin_[i] + r_cut) / cell_sizes_[i] - 0.5);
+    if (bounds_in_radius(point, r_cut, l_bounds, u_bounds)) {
+      iterate_sublattice(l_bounds, u_bounds, std::forward<F>(func));
     }
+  }
 
+  /**
+   * Same as iterate_in_radius(const ThreeVector&, double, F&&), but only the
+   * nodes in the z layers \f$k\in[z_{begin}, z_{end})\f$ are visited. For
+   * periodic lattices, also the periodic images of these layers are visited.
+   * The nodes are visited in the same order as without the restriction, so
+   * several threads filling disjoint layers obtain exactly the same results
+   * as a single one.
+   *
+   * \tparam F Type of the function. Arguments are the current node and the 3
+   * integer indices of the cell.
+   * \param[in] point Position, usually the position of particle [fm].
+   * \param[in] r_cut Maximum distance from the cell center to the
+   *            given position. [fm]
+   * \param[in] z_begin First z layer to be visited.
+   * \param[in] z_end Layer after the last z layer to be visited.
+   * \param[in] func Function acting on the cells (such as taking value).
+   */
+  template <typename F>
+  void iterate_in_radius(const ThreeVector& point, const double r_cut,
+                         int z_begin, int z_end, F&& func) {
+    std::array<int, 3> l_bounds, u_bounds;
+    if (!bounds_in_radius(point, r_cut, l_bounds, u_bounds)) {
+      return;
+    }
     if (!periodic_) {
-      for (int i = 0; i < 3; i++) {
-        if (l_bounds[i] < 0) {
-          l_bounds[i] = 0;
-        }
-        if (u_bounds[i] > n_cells_[i]) {
-          u_bounds[i] = n_cells_[i];
-        }
-        if (l_bounds[i] > n_cells_[i] || u_bounds[i] < 0) {
-          return;
-        }
+      l_bounds[2] = std::max(l_bounds[2], z_begin);
+      u_bounds[2] = std::min(u_bounds[2], z_end);
+      iterate_sublattice(l_bounds, u_bounds, func);
+      return;
+    }
+    const int z_lower = l_bounds[2];
+    const int z_upper = u_bounds[2];
+    for (int iz = z_lower; iz < z_upper; iz++) {
+      const int layer = positive_modulo(iz, n_cells_[2]);
+      if (layer >= z_begin && layer < z_end) {
+        l_bounds[2] = iz;
+        u_bounds[2] = iz + 1;
+        iterate_sublattice(l_bounds, u_bounds, func);
       }
     }
-    iterate_sublattice(l_bounds, u_bounds, std::forward<F>(func));
   }
 
   /**
@@ -357,6 +436,65 @@ class RectangularLattice {
   const LatticeUpdate when_update_;
 
  private:
+  /**
+   * Whether the tiles might hold values different from T(), see
+   * is_active_tile(). Several threads may mark tiles at the same time.
+   */
+  std::vector<std::atomic<bool>> active_tiles_;
+
+  /// Mark the tile of the node with 1d index \p index as active.
+  void activate(std::size_t index) {
+    active_tiles_[index / tile_size].store(true, std::memory_order_relaxed);
+  }
+
+  /// Mark all tiles as active.
+  void activate_all_tiles() {
+    for (auto &tile : active_tiles_) {
+      tile.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Find the index bounds of the nodes whose cell centers lie not further
+   * than r_cut in x, y, z directions from the given point. For non-periodic
+   * lattices, the bounds are restricted to the lattice.
+   *
+   * \param[in] point Position, usually the position of particle [fm].
+   * \param[in] r_cut Maximum distance from the cell center to the
+   *            given position. [fm]
+   * \param[out] l_bounds Lowest indices in x, y, z direction.
+   * \param[out] u_bounds Indices after the highest ones in x, y, z direction.
+   * \return Whether any node lies within r_cut.
+   */
+  bool bounds_in_radius(const ThreeVector& point, const double r_cut,
+                        std::array<int, 3>& l_bounds,
+                        std::array<int, 3>& u_bounds) const {
+    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
+     * where i is index in any direction. Therefore we want cells with condition
+     * (r-r_cut)*csize - 0.5 < i < (r+r_cut)*csize - 0.5, r = r_center - r_0 */
+    for (int i = 0; i < 3; i++) {
+      l_bounds[i] =
+          std::ceil((point[i] - origin_[i] - r_cut) / cell_sizes_[i] - 0.5);
+      u_bounds[i] =
+          std::ceil((point[i] - origin_[i] + r_cut) / cell_sizes_[i] - 0.5);
+    }
+
+    if (!periodic_) {
+      for (int i = 0; i < 3; i++) {
+        if (l_bounds[i] < 0) {
+          l_bounds[i] = 0;
+        }
+        if (u_bounds[i] > n_cells_[i]) {
+          u_bounds[i] = n_cells_[i];
+        }
+        if (l_bounds[i] > n_cells_[i] || u_bounds[i] < 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   /**
    * Returns division modulo, which is always between 0 and n-1
    * i%n is not suitable, because it returns results from -(n-1) to n-1
@@ -374,6 +512,9 @@ class RectangularLattice {
   }
 };
 
+template <typename T>
+constexpr std::size_t RectangularLattice<T>::tile_size;
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_LATTICE_H_
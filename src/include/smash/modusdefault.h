@@ -122,6 +122,29 @@ class ModusDefault {
     return {particles, min_cell_length, timestep_duration, strategy};
   }
 
+  /// The type of the Grid created by create_grid.
+  using GridType = Grid<GridOptions::Normal>;
+
+  /**
+   * Brings a Grid created by create_grid up to date with the current
+   * particles, such that it can be kept for the whole event.
+   *
+   * \param[in, out] grid The Grid to be updated.
+   * \param[in] particles The Particles object containing all particles of the
+   *                  currently running Experiment.
+   * \param[in] min_cell_length The minimal length of the grid cells.
+   * \param[in] timestep_duration Duration of the timestep.
+   * \param[in] strategy The strategy to determine the cell size
+   *
+   * \see Grid::update
+   */
+  void update_grid(
+      GridType &grid, const Particles &particles, double min_cell_length,
+      double timestep_duration,
+      CellSizeStrategy strategy = CellSizeStrategy::Optimal) const {
+    grid.update(particles, min_cell_length, timestep_duration, strategy);
+  }
+
   /**
    * Creates GrandCanThermalizer
    *
@@ -102,10 +102,6 @@ const std::initializer_list<double> KMINUSP_ELASTIC_SIG = {
     3.6200, 4.2300, 3.9500, 3.2400, 2.9600, 3.0100, 2.4600, 2.5600, 2.3300,
     2.5400, 2.5300, 2.5100, 2.5200, 2.7400, 2.5900};
 
-/// An interpolation that gets lazily filled using the KMINUSP_ELASTIC data.
-static std::unique_ptr<InterpolateDataLinear<double>>
-    kminusp_elastic_interpolation = nullptr;
-
 /// PDG data on K- p total cross section: momentum in lab frame.
 const std::initializer_list<double> KMINUSP_TOT_PLAB = {
     0.245,   0.255,   0.265,   0.275,   0.285,   0.293,   0.293,   0.295,
@@ -239,10 +235,6 @@ const std::initializer_list<double> KMINUSP_RES_SIG = {
     1.56038155638,  1.27216056674, 1.03167072054,  0.85006416230,
     0.39627220898,  0.57172926654, 0.51129452389,  0.44626386026};
 
-/// An interpolation that gets lazily filled using the KMINUSP_RES data.
-static std::unique_ptr<InterpolateDataSpline>
-    kminusp_elastic_res_interpolation = nullptr;
-
 /**
  * PDG data on K+ n total cross section: momentum in lab frame.
  * One data point is ignored because it is an outlier and messes up the
@@ -283,10 +275,6 @@ const std::initializer_list<double> KPLUSN_TOT_SIG = {
     18.30, 18.66, 18.56, 18.02, 18.43, 18.60, 19.04, 18.99, 19.23,
     19.63, 19.55, 19.74, 19.72, 19.82, 20.37, 20.61, 20.80};
 
-/// An interpolation that gets lazily filled using the KPLUSN_TOT data.
-static std::unique_ptr<InterpolateDataLinear<double>>
-    kplusn_total_interpolation = nullptr;
-
 /// PDG data on K+ p total cross section: momentum in lab frame.
 const std::initializer_list<double> KPLUSP_TOT_PLAB = {
     0.178,   0.265,   0.321,   0.351,   0.366,   0.405,   0.440,   0.451,
@@ -338,10 +326,6 @@ const std::initializer_list<double> KPLUSP_TOT_SIG = {
     18.06, 18.03, 18.37, 18.28, 18.17, 18.52, 18.40, 18.88, 18.70, 18.85, 19.14,
     19.52, 19.36, 19.33, 19.64, 18.20, 19.91, 19.84, 20.22, 20.45, 20.67};
 
-/// An interpolation that gets lazily filled using the KPLUSP_TOT data.
-static std::unique_ptr<InterpolateDataLinear<double>>
-    kplusp_total_interpolation = nullptr;
-
 /// PDG data on pi- p elastic cross section: momentum in lab frame.
 const std::initializer_list<double> PIMINUSP_ELASTIC_P_LAB = {
     0.09875, 0.14956, 0.21648, 0.21885, 0.22828, 0.24684, 0.25599, 0.26733,
@@ -379,10 +363,6 @@ const std::initializer_list<double> PIMINUSP_ELASTIC_SIG = {
     11.1,   9.69,   9.3,    8.91,   8.5,    7.7,    7.2,    7.2,    7.8,
     7.57,   6.1};
 
-/// An interpolation that gets lazily filled using the PIMINUSP_ELASTIC data.
-static std::unique_ptr<InterpolateDataLinear<double>>
-    piminusp_elastic_interpolation = nullptr;
-
 /// PDG data on pi- p to Lambda K0 cross section: momentum in lab frame.
 const std::initializer_list<double> PIMINUSP_LAMBDAK0_P_LAB = {
     0.904, 0.91,  0.919, 0.922, 0.926, 0.93,  0.931, 0.942, 0.945, 0.958, 0.964,
@@ -410,10 +390,6 @@ const std::initializer_list<double> PIMINUSP_LAMBDAK0_SIG = {
     0.16,  0.106,  0.12,  0.09,  0.09,  0.109,  0.084, 0.094, 0.087, 0.067,
     0.058, 0.0644, 0.049, 0.054, 0.038, 0.0221, 0.0157};
 
-/// An interpolation that gets lazily filled using the PIMINUSP_LAMBDAK0 data.
-static std::unique_ptr<InterpolateDataLinear<double>>
-    piminusp_lambdak0_interpolation = nullptr;
-
 /// PDG data on pi- p to Sigma- K+ cross section: momentum in lab frame
 const std::initializer_list<double> PIMINUSP_SIGMAMINUSKPLUS_P_LAB = {
     1.091, 1.128, 1.17, 1.22,  1.235, 1.284, 1.326, 1.5,  1.59,
@@ -428,13 +404,6 @@ const std::initializer_list<double> PIMINUSP_SIGMAMINUSKPLUS_SIG = {
     0.065, 0.057,  0.053,  0.051,  0.03,   0.031, 0.032, 0.022, 0.015,
     0.022, 0.0155, 0.0145, 0.0085, 0.0096, 0.005, 0.0045};
 
-/**
- * An interpolation that gets lazily filled using the
- * PIMINUSP_SIGMAMINUSKPLUS data.
- */
-static std::unique_ptr<InterpolateDataLinear<double>>
-    piminusp_sigmaminuskplus_interpolation = nullptr;
-
 /// pi- p to Sigma0 K0 cross section: square root s
 const std::initializer_list<double> PIMINUSP_SIGMA0K0_RES_SQRTS = {
     1.5,   1.516, 1.532, 1.548, 1.564, 1.58,  1.596, 1.612, 1.628, 1.644, 1.66,
@@ -474,13 +443,6 @@ const std::initializer_list<double> PIMINUSP_SIGMA0K0_RES_SIG = {
     0.02692862, 0.02603758, 0.02591122, 0.02537291, 0.02467199, 0.02466657,
     0.02370074, 0.02353027, 0.02362089, 0.0230085};
 
-/**
- * An interpolation that gets lazily filled using the
- * PIMINUSP_SIGMA0K0_RES data.
- */
-static std::unique_ptr<InterpolateDataLinear<double>>
-    piminusp_sigma0k0_interpolation = nullptr;
-
 /// Center-of-mass energy.
 const std::initializer_list<double> PIMINUSP_RES_SQRTS = {
     1.1438620, 1.1482410, 1.1514750, 1.1566800, 1.1572040, 1.1579910, 1.1665900,
@@ -628,10 +590,6 @@ const std::initializer_list<double> PIMINUSP_RES_SIG = {
     0.070291,  0.064685,  0.061942,  0.060365,  0.055497,  0.040625,  0.039905,
     0.027723,  0.022456,  0.017122,  0.016299,  0.014606};
 
-/// An interpolation that gets lazily filled using the PIMINUSP_RES data.
-static std::unique_ptr<InterpolateDataSpline>
-    piminusp_elastic_res_interpolation = nullptr;
-
 /// PDG data on pi+ p elastic cross section: momentum in lab frame.
 const std::initializer_list<double> PIPLUSP_ELASTIC_P_LAB = {
     0.09875, 0.13984, 0.14956, 0.33138, 0.378,   0.408,   0.4093,  0.427,
@@ -667,10 +625,6 @@ const std::initializer_list<double> PIPLUSP_ELASTIC_SIG = {
     4.75,  4.2,   4.54,  4.46,  4.21,  4.21,  3.98,  3.19,  3.37,  3.16,  3.29,
     3.1,   3.35,  3.3,   3.39,  3.24,  3.37,  3.17,  3.3};
 
-/// An interpolation that gets lazily filled using the PIPLUSP_ELASTIC_SIG data.
-static std::unique_ptr<InterpolateDataLinear<double>>
-    piplusp_elastic_interpolation = nullptr;
-
 /// PDG data on pi+ p to Sigma+ K+ cross section: momentum in lab frame.
 const std::initializer_list<double> PIPLUSP_SIGMAPLUSKPLUS_P_LAB = {
     1.041, 1.105, 1.111, 1.15,  1.157, 1.17,  1.195, 1.206, 1.218, 1.222, 1.265,
@@ -690,13 +644,6 @@ const std::initializer_list<double> PIPLUSP_SIGMAPLUSKPLUS_SIG = {
     0.23,   0.242,  0.22,  0.217,  0.234, 0.165, 0.168, 0.104, 0.059, 0.059,
     0.0297, 0.0371, 0.02,  0.0202, 0.0143};
 
-/**
- * An interpolation that gets lazily filled using the
- * PIPLUSP_SIGMAPLUSKPLUS_SIG data.
- */
-static std::unique_ptr<InterpolateDataLinear<double>>
-    piplusp_sigmapluskplus_interpolation = nullptr;
-
 /// Center-of-mass energy.
 const std::initializer_list<double> PIPLUSP_RES_SQRTS = {
     1.1173610, 1.1241380, 1.1358180, 1.1371030, 1.1380990, 1.1424360, 1.1457360,
@@ -813,10 +760,6 @@ const std::initializer_list<double> PIPLUSP_RES_SIG = {
     0.207660,   0.201536,   0.194611,   0.190406,   0.187587,   0.180499,
     0.173394,   0.159321,   0.145738,   0.132952,   0.123434,   0.088815,
     0.079356,   0.042881,   0.041067,   0.026625,   0.026107};
-
-/// A null interpolation that gets filled using the PIPLUSP_RES data
-static std::unique_ptr<InterpolateDataSpline>
-    piplusp_elastic_res_interpolation = nullptr;
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_PARAMETRIZATIONS_DATA_H_
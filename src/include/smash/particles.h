@@ -7,6 +7,8 @@
 #ifndef SRC_INCLUDE_SMASH_PARTICLES_H_
 #define SRC_INCLUDE_SMASH_PARTICLES_H_
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -108,6 +110,16 @@ class Particles {
    */
   void reset();
 
+  /**
+   * Replace the contents of this object by an exact copy of \p other. In
+   * contrast to insert(), particle ids and the id counter are preserved, so
+   * the copy can stand in for \p other, e.g. when an output is written at a
+   * later time.
+   *
+   * \param[in] other The Particles object to be copied.
+   */
+  void copy_from(const Particles &other);
+
   /**
    * Check whether the ParticleData copy is still a valid copy of the one
    * stored in the Particles object.
@@ -130,6 +142,28 @@ class Particles {
            && data_[copy.index_].id_process() == copy.id_process();
   }
 
+  /**
+   * \return The index of the valid copy \p p in the internal storage. It stays
+   * the same as long as the particle is in the list, also if its state is
+   * updated, and allows to keep track of the particles in auxiliary data
+   * structures. A removed particle's index is reused for new particles.
+   *
+   * \param[in] p ParticleData copy obtained from Particles
+   */
+  static unsigned storage_index(const ParticleData &p) { return p.index_; }
+
+  /**
+   * \return The particle at the given position of the internal storage, see
+   * storage_index().
+   *
+   * \param[in] storage_index Index of a particle that is in the list.
+   */
+  const ParticleData &at_storage_index(unsigned storage_index) const {
+    assert(storage_index < data_size_);
+    assert(!data_[storage_index].hole_);
+    return data_[storage_index];
+  }
+
   /**
    * Remove the given particle \p p from the list. The argument \p p must be a
    * valid copy obtained from Particles, i.e. a call to \ref is_valid must
@@ -489,6 +523,123 @@ class Particles {
   std::vector<unsigned> dirty_;
 };
 
+/**
+ * \ingroup data
+ *
+ * A read-only list of particles that does not own them. The particles are
+ * either the elements of a ParticleList or the particles at a list of storage
+ * indices (see Particles::storage_index) in a Particles object. The latter is
+ * how the Grid hands out its cells without copying the particles.
+ *
+ * The view refers to the list or to the Particles object and the indices,
+ * which therefore have to outlive it and must not be modified while it is
+ * used.
+ */
+class ParticleListView {
+ public:
+  /**
+   * Constructs a view of all particles in \p list.
+   *
+   * \param[in] list The particles in the view.
+   */
+  ParticleListView(const ParticleList &list)  // NOLINT(runtime/explicit)
+      : list_(list.data()), size_(list.size()) {}
+
+  /**
+   * Constructs a view of the particles at \p storage_indices in \p
+   * particles.
+   *
+   * \param[in] particles The particles the indices refer to.
+   * \param[in] storage_indices Storage indices of particles in \p particles.
+   */
+  ParticleListView(const Particles &particles,
+                   const std::vector<unsigned> &storage_indices)
+      : particles_(&particles),
+        indices_(storage_indices.data()),
+        size_(storage_indices.size()) {}
+
+  /// \return the number of particles in the view.
+  std::size_t size() const { return size_; }
+
+  /// \return whether the view is empty.
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * \return the particle at position \p i of the view.
+   *
+   * \param[in] i Position in the view, smaller than size().
+   */
+  const ParticleData &operator[](std::size_t i) const {
+    assert(i < size_);
+    return particles_ ? particles_->at_storage_index(indices_[i]) : list_[i];
+  }
+
+  /// Forward iterator over the particles of a ParticleListView.
+  class const_iterator {
+   public:
+    /// The iterator category
+    using iterator_category = std::forward_iterator_tag;
+    /// The type of the particles
+    using value_type = ParticleData;
+    /// The type of the difference between two iterators
+    using difference_type = std::ptrdiff_t;
+    /// The pointer to a particle
+    using pointer = const ParticleData *;
+    /// The reference to a particle
+    using reference = const ParticleData &;
+
+    /**
+     * Constructs an iterator to position \p i of \p view.
+     *
+     * \param[in] view The view iterated over.
+     * \param[in] i Position in the view.
+     */
+    const_iterator(const ParticleListView *view, std::size_t i)
+        : view_(view), i_(i) {}
+
+    /// \return the particle the iterator points to.
+    reference operator*() const { return (*view_)[i_]; }
+    /// \return a pointer to the particle the iterator points to.
+    pointer operator->() const { return &(*view_)[i_]; }
+    /// Advances the iterator to the next particle. \return this iterator.
+    const_iterator &operator++() {
+      ++i_;
+      return *this;
+    }
+    /// Advances the iterator. \return the iterator before the increment.
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++i_;
+      return old;
+    }
+    /// \return whether both iterators point to the same position.
+    bool operator==(const const_iterator &rhs) const { return i_ == rhs.i_; }
+    /// \return whether the iterators point to different positions.
+    bool operator!=(const const_iterator &rhs) const { return i_ != rhs.i_; }
+
+   private:
+    /// The view iterated over.
+    const ParticleListView *view_;
+    /// Position in the view.
+    std::size_t i_;
+  };
+
+  /// \return an iterator to the first particle.
+  const_iterator begin() const { return {this, 0}; }
+  /// \return an iterator behind the last particle.
+  const_iterator end() const { return {this, size_}; }
+
+ private:
+  /// The particles of a view of a ParticleList, otherwise nullptr.
+  const ParticleData *list_ = nullptr;
+  /// The particles of a view of storage indices, otherwise nullptr.
+  const Particles *particles_ = nullptr;
+  /// The storage indices in \ref particles_ of the particles in the view.
+  const unsigned *indices_ = nullptr;
+  /// The number of particles in the view.
+  std::size_t size_ = 0;
+};
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_PARTICLES_H_
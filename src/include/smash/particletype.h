@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_SMASH_PARTICLETYPE_H_
 
 #include <cassert>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "forwarddeclarations.h"
 #include "macros.h"
 #include "pdgcode.h"
+#include "sha256.h"
 
 namespace smash {
 
@@ -291,6 +293,9 @@ class ParticleType {
   /**
    * Get the mass-dependent total width of a particle with mass m.
    *
+   * Interpolated from the tabulation, if tabulate_widths() was called and
+   * \p m lies within it.
+   *
    * \param[in] m Invariant mass of the decaying particle.
    * \return the total width for all modes for this mass
    */
@@ -307,6 +312,8 @@ class ParticleType {
 
   /**
    * Get all the mass-dependent partial decay widths of a particle with mass m.
+   * Like total_width(), they are interpolated from the tabulations if
+   * available.
    * This function needs to know the 4-momentum and the position of the decaying
    * particle to calculate the square root of s of the final state particles and
    * mass \param[in] p 4-momentum of the decaying particle. \param[in] x
@@ -317,6 +324,20 @@ class ParticleType {
   DecayBranchList get_partial_widths(const FourVector p, const ThreeVector x,
                                      WhichDecaymodes wh) const;
 
+  /**
+   * Get all the mass-dependent partial decay widths of a particle, like
+   * above, but without allocating: the widths are written into \p widths,
+   * indexed like the decay mode list. Modes that are not selected by \p wh
+   * or closed at this mass get a width of 0.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x Position of the decaying particle.
+   * \param[in] wh Enum that decides which decay modes are evaluated.
+   * \param[out] widths Buffer for the partial widths.
+   */
+  void get_partial_widths(const FourVector p, const ThreeVector x,
+                          WhichDecaymodes wh, DecayWidths *widths) const;
+
   /**
    * Get the mass-dependent partial width of a resonance with mass m,
    * decaying into two given daughter particles.
@@ -414,6 +435,21 @@ class ParticleType {
                                                     const double cms_energy,
                                                     int L = 0) const;
 
+  /**
+   * Tabulate upper bounds of the ratio of the spectral function to the
+   * distribution the resonance masses are drawn from, as a function of the
+   * largest possible mass. They are the rejection bounds of
+   * sample_resonance_mass() and sample_resonance_masses(), so the number of
+   * random numbers drawn for a mass only depends on the random state and not
+   * on earlier samplings. Nothing happens if the bounds are already
+   * tabulated; tabulate_spectral_functions() tabulates them anew.
+   *
+   * This has to be called before any concurrent use of the type, see
+   * initialize_physics_tables(). Without the tabulation, a heuristic bound is
+   * used.
+   */
+  void tabulate_spectral_ratio_bounds() const;
+
   /**
    * Prints out width and spectral function versus mass to the
    * standard output. This is useful for debugging and analysis.
@@ -555,6 +591,45 @@ class ParticleType {
    */
   static void check_consistency();
 
+  /**
+   * Tabulate the total width and the partial widths of all decay modes of all
+   * unstable types on a mass grid with 1 MeV spacing, from the lowest decay
+   * threshold up to 2 GeV (or 10 pole widths, if more) above the pole mass.
+   * Afterwards, total_width(), get_partial_widths() and get_partial_width()
+   * interpolate linearly within this range, instead of evaluating every decay
+   * mode. The tabulations are read from and written to \p tabulations_path,
+   * one file per type.
+   *
+   * This has to be called before any concurrent use of the types.
+   *
+   * \param[in] hash The hash of the particle properties. Cached tabulations
+   *            are only used if it matches.
+   * \param[in] tabulations_path The directory of the cached tabulations, no
+   *            caching if empty.
+   */
+  static void tabulate_widths(sha256::Hash hash,
+                              const bf::path &tabulations_path);
+
+  /**
+   * Tabulate the spectral functions of all unstable types on the same mass
+   * grid as in tabulate_widths(), starting at min_mass_spectral(). The
+   * resonance mass sampling then draws the masses from these tabulations in
+   * constant time, using a Cauchy tail above them, and only has to correct
+   * for the small difference to the real spectral function by rejection.
+   * The tabulations are read from and written to \p tabulations_path, one
+   * file per type.
+   *
+   * This has to be called after tabulate_widths() and before any concurrent
+   * use of the types.
+   *
+   * \param[in] hash The hash of the particle properties. Cached tabulations
+   *            are only used if it matches.
+   * \param[in] tabulations_path The directory of the cached tabulations, no
+   *            caching if empty.
+   */
+  static void tabulate_spectral_functions(sha256::Hash hash,
+                                          const bf::path &tabulations_path);
+
   /**
    * Returns an object that acts like a pointer, except that it requires only 2
    * bytes and inhibits pointer arithmetics.
@@ -641,10 +716,69 @@ class ParticleType {
   /// Container for the isospin multiplet information
   IsoParticleType *iso_multiplet_ = nullptr;
 
-  /// Maximum factor for single-res mass sampling, cf. sample_resonance_mass.
-  mutable double max_factor1_ = 1.;
-  /// Maximum factor for double-res mass sampling, cf. sample_resonance_masses.
-  mutable double max_factor2_ = 1.;
+  /**
+   * \return The partial width of the \p i-th decay mode at mass \p m,
+   * interpolated from the tabulation if possible.
+   *
+   * \param[in] m Invariant mass of the decaying particle.
+   * \param[in] i Index of the mode in the decay mode list.
+   */
+  double mode_width(double m, std::size_t i) const;
+
+  /**
+   * Sample a mass between min_mass_spectral() and \p max_mass from the
+   * tabulated spectral function (see tabulate_spectral_functions()), or from
+   * a simple Breit-Wigner distribution if it is not tabulated.
+   *
+   * \param[in] max_mass Largest possible mass [GeV].
+   * \return The mass and the ratio of the spectral function to the density
+   * it was sampled from.
+   */
+  std::pair<double, double> sample_spectral_mass(double max_mass) const;
+
+  /**
+   * \return The ratio of the spectral function to the density of the
+   * distribution sample_spectral_mass() draws the masses from.
+   *
+   * \param[in] m Resonance mass [GeV].
+   */
+  double spectral_ratio(double m) const;
+
+  /**
+   * \return An upper bound of the ratio returned by sample_spectral_mass(),
+   * from the tabulated running maximum (see tabulate_spectral_ratio_bounds())
+   * or else a heuristic one. The callers correct it locally, if it turns out
+   * to be too small.
+   *
+   * \param[in] max_mass Largest possible mass [GeV].
+   */
+  double spectral_ratio_bound(double max_mass) const;
+
+  /**
+   * \return The factor that continues the tabulated spectral function by a
+   * Cauchy distribution above the tabulation.
+   */
+  double mass_tail_factor() const;
+
+  /**
+   * Tabulated widths, see tabulate_widths(): the total width first, followed
+   * by the partial widths of the decay modes in the order of the decay mode
+   * list. nullptr if not tabulated. Mutable, because it is set after the
+   * type list is complete and does not change the logical state.
+   */
+  mutable std::shared_ptr<const std::vector<Tabulation>> width_tabulations_;
+
+  /**
+   * Tabulated spectral function for the mass sampling, see
+   * tabulate_spectral_functions(). nullptr if not tabulated.
+   */
+  mutable std::shared_ptr<const InverseCdfTabulation> mass_tabulation_;
+
+  /**
+   * Running maximum of spectral_ratio() up to (slightly above) the tabulated
+   * mass, see tabulate_spectral_ratio_bounds(). nullptr if not tabulated.
+   */
+  mutable std::shared_ptr<const Tabulation> spectral_ratio_bounds_;
 
   /**\ingroup logging
    * Writes all information about the particle type to the output stream.
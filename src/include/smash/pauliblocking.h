@@ -10,6 +10,11 @@
 #ifndef SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 #define SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 #include "configuration.h"
 #include "experimentparameters.h"
 #include "forwarddeclarations.h"
@@ -48,9 +53,35 @@ class PauliBlocker {
   /// Destructor
   ~PauliBlocker();
 
+  /**
+   * Build an index of all baryons of \p particles by their position and
+   * momentum, such that phasespace_dens only has to look at the particles
+   * in the vicinity. The index stays valid while the particles propagate by
+   * at most \p max_displacement and as long as all changes of \p particles
+   * by actions are passed to update_index(const ParticleList &, const
+   * ParticleList &). It has to be rebuilt if the momenta change otherwise.
+   *
+   * \param[in] particles All current particles.
+   * \param[in] max_displacement Largest distance any particle will propagate
+   *            before the index is rebuilt [fm].
+   */
+  void update_index(const Particles &particles, double max_displacement);
+
+  /**
+   * Update the index for a performed action.
+   *
+   * \param[in] incoming Particles that were removed.
+   * \param[in] outgoing Particles that were inserted.
+   */
+  void update_index(const ParticleList &incoming, const ParticleList &outgoing);
+
   /**
    * Calculate phase-space density of a particle species at the point (r,p).
    *
+   * If \p particles is indexed (see update_index()), only the particles in
+   * the neighboring cells of the index are considered. Otherwise all
+   * particles are.
+   *
    * \param[in] r Position vector of the particle.
    * \param[in] p Momentum vector of the particle.
    * \param[in] particles List of all current particles.
@@ -72,6 +103,44 @@ class PauliBlocker {
   /// Analytical calculation of weights
   void init_weights_analytical();
 
+  /**
+   * Add the contribution of one particle to the phase-space density.
+   *
+   * \param[in] part The particle.
+   * \param[in] r Position at which the density is calculated.
+   * \param[in] p Momentum at which the density is calculated.
+   * \param[in] pdg PDG code of the species.
+   * \param[in] disregard Particles that should not be counted.
+   * \param[inout] f Phase-space density to be increased.
+   */
+  void add_to_density(const ParticleData &part, const ThreeVector &r,
+                      const ThreeVector &p, const PdgCode pdg,
+                      const ParticleList &disregard, double &f) const;
+
+  /**
+   * \return The key of the index cell of a species at a given position and
+   * momentum, given by their cell coordinates. Different cells may share the
+   * same key, which only makes phasespace_dens check more particles.
+   *
+   * \param[in] pdg PDG code of the species.
+   * \param[in] cell Cell coordinates: 3 in position, 3 in momentum space.
+   */
+  static std::uint64_t cell_key(const PdgCode pdg,
+                                const std::array<int, 6> &cell);
+
+  /**
+   * \return The cell coordinates of \p part in the index.
+   *
+   * \param[in] part The particle.
+   */
+  std::array<int, 6> cell_of(const ParticleData &part) const;
+
+  /// Add \p part to the index, if it is a baryon.
+  void insert_into_index(const ParticleData &part);
+
+  /// Remove \p part from the index.
+  void remove_from_index(const ParticleData &part);
+
   /// Standard deviation of the gaussian used for smearing
   double sig_;
 
@@ -89,6 +158,21 @@ class PauliBlocker {
 
   /// Weights: tabulated results of numerical integration
   std::array<double, 30> weights_;
+
+  /// The particles that are indexed, nullptr if there is no index
+  const Particles *indexed_particles_ = nullptr;
+
+  /**
+   * Edge length of the index cells in coordinate space: the averaging
+   * radius rr_ + rc_ plus the largest displacement since indexing [fm]
+   */
+  double index_dr_ = 0.;
+
+  /// Baryons in the cells of the index, at the time they were indexed
+  std::unordered_map<std::uint64_t, ParticleList> index_;
+
+  /// The key of the cell of every indexed particle, by particle id
+  std::unordered_map<int, std::uint64_t> index_key_;
 };
 }  // namespace smash
 
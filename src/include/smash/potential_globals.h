@@ -15,14 +15,19 @@
 
 namespace smash {
 
+/*
+ * The pointers are thread-local, because every thread running events sets them
+ * to the lattices of its own Experiment.
+ */
+
 /// Pointer to the skyrme potential on the lattice
-extern RectangularLattice<FourVector> *UB_lat_pointer;
+extern thread_local RectangularLattice<FourVector> *UB_lat_pointer;
 
 /// Pointer to the symmmetry potential on the lattice
-extern RectangularLattice<FourVector> *UI3_lat_pointer;
+extern thread_local RectangularLattice<FourVector> *UI3_lat_pointer;
 
 /// Pointer to a Potential class
-extern Potentials *pot_pointer;
+extern thread_local Potentials *pot_pointer;
 
 }  // namespace smash
 
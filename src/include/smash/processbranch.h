@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "allocationpool.h"
 #include "decaytype.h"
 #include "forwarddeclarations.h"
 #include "particletype.h"
@@ -151,6 +152,27 @@ class ProcessBranch {
    */
   virtual ~ProcessBranch() = default;
 
+  /**
+   * Branches are allocated from a pool, because many of them are
+   * short-lived, see allocation_pool.
+   *
+   * \param[in] size Size of the branch in bytes.
+   * \return Memory for the branch.
+   */
+  static void *operator new(std::size_t size) {
+    return allocation_pool::allocate(size);
+  }
+
+  /**
+   * Returns the memory of a branch to the pool.
+   *
+   * \param[in] pointer Memory of the branch.
+   * \param[in] size Size of the branch in bytes.
+   */
+  static void operator delete(void *pointer, std::size_t size) noexcept {
+    allocation_pool::deallocate(pointer, size);
+  }
+
   /**
    * Set the weight of the branch.
    * In other words, how probable this branch is
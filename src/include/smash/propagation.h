@@ -99,8 +99,10 @@ void expand_space_time(Particles *particles,
  *            components of the Skyrme force
  * \param[in] FI3_lat Lattice for the electric and magnetic
  *            components of the symmetry force
+ * \return The shortest time scale on which the forces change the momenta
+ *         [fm/c], infinity if no particle is accelerated.
  */
-void update_momenta(
+double update_momenta(
     Particles *particles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat);
@@ -26,8 +26,11 @@ namespace random {
 /// The random number engine used is the Mersenne Twister.
 using Engine = std::mt19937_64;
 
-/// The engine that is used commonly by all distributions.
-extern /*thread_local (see #3075)*/ Engine engine;
+/**
+ * The engine that is used commonly by all distributions. Each thread has its
+ * own engine, such that events can be run concurrently.
+ */
+extern thread_local Engine engine;
 
 /** Provides uniform random numbers on a fixed interval.
  *
@@ -66,6 +69,21 @@ class uniform_dist {
 /** Generates a seed with a truly random 63-bit value, if possible */
 int64_t generate_63bit_seed();
 
+/**
+ * Derives the seed of one random number stream from the master seed in a
+ * counter-based way: The seed is a hash (based on the SplitMix64 finalizer)
+ * of the key (master seed, event number, stream id). It does not depend on
+ * any other event, so every event can be reproduced in isolation and the
+ * results do not depend on the order in which the events are run.
+ *
+ * \param master_seed The seed given in the configuration.
+ * \param event_number Number of the event.
+ * \param stream Id distinguishing independent streams within one event.
+ * \return A non-negative 63-bit seed.
+ */
+int64_t stream_seed(int64_t master_seed, int64_t event_number,
+                    int64_t stream = 0);
+
 /** Sets the seed of the random number engine. */
 template <typename T>
 void set_seed(T &&seed) {
@@ -74,7 +74,22 @@ class ScatterAction : public Action {
    *
    * \return  squared distance \f$d^2_\mathrm{coll}\f$.
    */
-  double transverse_distance_sqr() const;
+  double transverse_distance_sqr() const {
+    return transverse_distance_sqr(incoming_particles_[0],
+                                   incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the transverse distance of two particles in their center of
+   * mass frame, see above. This does not need a ScatterAction object and can
+   * be used to reject a pair before constructing one.
+   *
+   * \param[in] p_a First particle.
+   * \param[in] p_b Second particle.
+   * \return  squared distance \f$d^2_\mathrm{coll}\f$.
+   */
+  static double transverse_distance_sqr(const ParticleData &p_a,
+                                        const ParticleData &p_b);
 
   /**
    * Calculate the transverse distance of the two incoming particles in their
@@ -83,7 +98,21 @@ class ScatterAction : public Action {
    *
    * \return squared distance  \f$d^2_\mathrm{coll}\f$.
    */
-  double cov_transverse_distance_sqr() const;
+  double cov_transverse_distance_sqr() const {
+    return cov_transverse_distance_sqr(incoming_particles_[0],
+                                       incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the covariant transverse distance of two particles, see
+   * above. This does not need a ScatterAction object.
+   *
+   * \param[in] p_a First particle.
+   * \param[in] p_b Second particle.
+   * \return squared distance  \f$d^2_\mathrm{coll}\f$.
+   */
+  static double cov_transverse_distance_sqr(const ParticleData &p_a,
+                                            const ParticleData &p_b);
   /**
    * Determine the Mandelstam s variable,
    *
@@ -18,6 +18,7 @@
 #include "actionfinderfactory.h"
 #include "configuration.h"
 #include "scatteraction.h"
+#include "sha256.h"
 
 namespace smash {
 
@@ -165,13 +166,14 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * \return A list of possible scatter actions
    */
   ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double gcell_vol,
+      const ParticleListView &search_list, double dt, const double gcell_vol,
       const std::vector<FourVector> &beam_momentum) const override;
 
   /**
    * Search for all the possible collisions among the neighboring cells. This
-   * function is only used for counting the primary collisions at the beginning
-   * of each time step.
+   * function is used for counting the primary collisions at the beginning of
+   * each time step and, with the particles around the outgoing particles of an
+   * action as \p neighbors_list, for the secondary collisions.
    *
    * \param[in] search_list A list of particles within the current cell
    * \param[in] neighbors_list A list of particles within the neighboring cell
@@ -181,8 +183,9 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * \return A list of possible scatter actions
    */
   ActionList find_actions_with_neighbors(
-      const ParticleList &search_list, const ParticleList &neighbors_list,
-      double dt, const std::vector<FourVector> &beam_momentum) const override;
+      const ParticleListView &search_list,
+      const ParticleListView &neighbors_list, double dt,
+      const std::vector<FourVector> &beam_momentum) const override;
 
   /**
    * Search for all the possible secondary collisions between the outgoing
@@ -274,7 +277,60 @@ class ScatterActionsFinder : public ActionFinderInterface {
     }
   }
 
+  /**
+   * Sets where the tabulated upper bounds of the total cross sections (see
+   * cross_section_upper_bound) are cached between runs. They are stored next
+   * to the tabulations of IsoParticleType::tabulate_integrals.
+   *
+   * \param[in] hash Hash of the SMASH version, the particles and the decay
+   *                 modes.
+   * \param[in] tabulations_path Directory of the tabulations. If empty, the
+   *                             bounds are only kept in memory.
+   */
+  static void set_tabulation_directory(sha256::Hash hash,
+                                       const bf::path &tabulations_path);
+
+  /**
+   * An upper bound of the total cross section of two particles, which is
+   * cheaper to evaluate than the cross section itself.
+   *
+   * For each pair of stable particle types, the total cross section without
+   * potentials is tabulated as function of \f$\sqrt{s}\f$ on first use. In
+   * every bin of 10 MeV, the maximum of the cross sections sampled every
+   * MeV, including both bin edges, is stored. The tabulations only depend
+   * on the parameters, not on the events, and are shared between all
+   * finders with the same parameters.
+   *
+   * Potentials shift the thresholds of the channels in both directions and
+   * can therefore increase the cross section. No bound is given while they
+   * affect the thresholds.
+   *
+   * \param[in] data_a First particle.
+   * \param[in] data_b Second particle.
+   * \return The upper bound [mb], or a negative value if there is none for
+   *         this pair, e.g. if one of the particles is unstable,
+   *         \f$\sqrt{s}\f$ is beyond the tabulated range or potentials are
+   *         used.
+   */
+  double cross_section_upper_bound(const ParticleData &data_a,
+                                   const ParticleData &data_b) const;
+
  private:
+  /// Tabulated upper bounds of the total cross sections.
+  class CrossSectionBounds;
+
+  /**
+   * Calculates the total cross section of two particles of the given types
+   * with their pole masses at the given \f$\sqrt{s}\f$, without potentials.
+   *
+   * \param[in] type_a Type of the first particle.
+   * \param[in] type_b Type of the second particle.
+   * \param[in] sqrts Center of mass energy [GeV].
+   * \return The total cross section [mb].
+   */
+  double total_cross_section(const ParticleType &type_a,
+                             const ParticleType &type_b, double sqrts) const;
+
   /**
    * Check for a single pair of particles (id_a, id_b) if a collision will
    * happen in the next timestep and create a corresponding Action object
@@ -383,6 +439,11 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * over 1.
    */
   const bool only_warn_for_high_prob_;
+  /**
+   * Upper bounds of the total cross sections of pairs of stable particles,
+   * nullptr for a constant elastic isotropic cross section.
+   */
+  std::shared_ptr<CrossSectionBounds> cross_section_bounds_;
 };
 
 }  // namespace smash
@@ -30,6 +30,20 @@ std::pair<std::string, std::string> load_particles_and_decaymodes(
 /// Loads default smash particle list and decaymodes
 void load_default_particles_and_decaymodes();
 
+/**
+ * Builds all quantities of the particle types and decay modes that are
+ * otherwise computed lazily on first use: minimal masses, isospins,
+ * normalizations of the spectral functions, decay thresholds, the
+ * tabulations of the mass-dependent widths and the rejection bounds of the
+ * resonance mass sampling.
+ *
+ * Afterwards, the particle and decay mode data are only read during a
+ * simulation, such that they can be shared by several Experiments running
+ * concurrently in one process. This has to be called after the particles and
+ * decay modes are loaded and before any concurrent use.
+ */
+void initialize_physics_tables();
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_SETUP_PARTICLES_DECAYMODES_H_
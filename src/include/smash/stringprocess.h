@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -186,6 +187,14 @@ class StringProcess {
   /// An object to compute cross-sections
   Pythia8::SigmaTotal pythia_sigmatot_;
 
+  /**
+   * Serializes the use of pythia_sigmatot_ and the particle data of
+   * pythia_hadron_ in cross_sections_diffractive, because the cross sections
+   * are also computed while finding actions, which can be done by several
+   * threads (see \key Threads_Per_Event).
+   */
+  std::mutex sigmatot_mutex_;
+
   /**
    * An object for the flavor selection in string fragmentation
    * in the case of separate fragmentation function for leading baryon
@@ -308,6 +317,7 @@ class StringProcess {
    */
   std::array<double, 3> cross_sections_diffractive(int pdg_a, int pdg_b,
                                                    double sqrt_s) {
+    std::lock_guard<std::mutex> lock(sigmatot_mutex_);
     // This threshold magic is following Pythia. Todo(ryu): take care of this.
     double sqrts_threshold = 2. * (1. + 1.0e-6);
     /* In the case of mesons, the corresponding vector meson masses
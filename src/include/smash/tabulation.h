@@ -58,6 +58,12 @@ class Tabulation {
    */
   bool is_empty() const { return values_.empty(); }
 
+  /// \return The lower bound of the tabulation domain.
+  double x_min() const { return x_min_; }
+
+  /// \return The upper bound of the tabulation domain.
+  double x_max() const { return x_max_; }
+
   /**
    * Construct a tabulation object by reading binary data from a stream.
    *
@@ -119,6 +125,81 @@ class Tabulation {
   double inv_dx_;
 };
 
+/**
+ * A tabulated probability density that can be sampled in constant time by
+ * inverting its cumulative distribution function.
+ *
+ * The density is tabulated at the points of a Tabulation. Within each
+ * interval it is approximated by the larger of the two tabulated values, so
+ * the approximation lies (almost) everywhere above the real density; an exact
+ * distribution is obtained by rejecting samples with the ratio of both, see
+ * density(). To locate the interval for a given value of the cumulative
+ * distribution, a guide table with one entry per interval is used, such that
+ * on average less than two intervals have to be checked.
+ */
+class InverseCdfTabulation : public Tabulation {
+ public:
+  /**
+   * Construct a new table of the density \p f.
+   *
+   * \param x_min lower bound of the domain
+   * \param range range (x_max-x_min) of the domain
+   * \param num number of intervals
+   * \param f non-negative density, does not need to be normalized
+   * \throws if less than two values are tabulated.
+   */
+  InverseCdfTabulation(double x_min, double range, size_t num,
+                       std::function<double(double)> f);
+
+  /**
+   * Construct the table from tabulated values of the density, e.g. as read
+   * by Tabulation::from_file.
+   *
+   * \param density Tabulated density, must not be empty.
+   */
+  explicit InverseCdfTabulation(Tabulation density);
+
+  /**
+   * \return The approximate density that is sampled at \p x, i.e. the larger
+   * of the two tabulated values around it; 0 outside of the domain.
+   *
+   * \param x Argument of the density.
+   */
+  double density(double x) const;
+
+  /**
+   * \return The integral of the approximate density from the lower bound to
+   * \p x, or over the whole domain if \p x is above it.
+   *
+   * \param x Upper bound of the integral.
+   */
+  double cumulative(double x) const;
+
+  /**
+   * \return The argument at which cumulative() equals \p u.
+   *
+   * \param u Value of the cumulative distribution, between 0 and
+   *          cumulative(x_max()).
+   */
+  double inverse(double u) const;
+
+ private:
+  /// Compute the cumulative distribution and the guide table.
+  void init();
+
+  /// Approximate density in every interval
+  std::vector<double> density_;
+
+  /// Cumulative distribution at the tabulated points
+  std::vector<double> cdf_;
+
+  /**
+   * For every interval of equal size of the cumulative distribution, the
+   * first interval of the domain that reaches into it.
+   */
+  std::vector<size_t> guide_;
+};
+
 /**
  * Spectral function integrand for GSL integration, with one resonance in the
  * final state (the second particle is stable).
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_THREADPOOL_H_
+#define SRC_INCLUDE_SMASH_THREADPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * A fixed set of threads that repeatedly run a common piece of work.
+ *
+ * The helper threads are started once and wait in between, so parallel
+ * sections that are entered at every time step do not pay for creating and
+ * joining threads. The thread calling run() takes part in the work, thus a
+ * pool of size n starts n - 1 helper threads. Thread-local data of the
+ * helpers persists from one call of run() to the next.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Starts the helper threads.
+   *
+   * \param[in] n_threads Number of threads running the work, including the
+   *                      calling thread. Values smaller than 2 start no
+   *                      helper threads.
+   */
+  explicit ThreadPool(int n_threads);
+
+  /// Stops and joins the helper threads.
+  ~ThreadPool();
+
+  /// Cannot be copied
+  ThreadPool(const ThreadPool &) = delete;
+  /// Cannot be copied
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// \return the number of threads running the work, including the caller.
+  int size() const { return static_cast<int>(helpers_.size()) + 1; }
+
+  /**
+   * Calls \p work once on every thread of the pool, including the calling
+   * thread, and returns when all calls have returned. Typically, \p work
+   * takes its tasks from a shared atomic counter until none are left.
+   *
+   * run() must not be called concurrently or from within \p work.
+   *
+   * \param[in] work The work to be run on every thread.
+   * \throw Rethrows an exception thrown by \p work on any thread, after all
+   *        threads have finished.
+   */
+  void run(const std::function<void()> &work);
+
+ private:
+  /// The loop of every helper thread, which waits for work until stopped.
+  void serve();
+
+  /// The helper threads.
+  std::vector<std::thread> helpers_;
+
+  /// Protects all following members.
+  std::mutex mutex_;
+
+  /// Notifies the helpers of new work or of the end of the pool.
+  std::condition_variable wake_;
+
+  /// Notifies run() that the helpers have finished.
+  std::condition_variable done_;
+
+  /// The work of the current call of run(), nullptr in between.
+  const std::function<void()> *work_ = nullptr;
+
+  /// Counts the calls of run(), such that a helper runs every work once.
+  std::uint64_t generation_ = 0;
+
+  /// Number of helpers still running the current work.
+  std::size_t busy_ = 0;
+
+  /// The first exception thrown by the work on a helper thread.
+  std::exception_ptr failure_;
+
+  /// Whether the helpers have to stop.
+  bool stop_ = false;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_THREADPOOL_H_
@@ -64,12 +64,12 @@ class WallCrossActionsFinder : public ActionFinderInterface {
    * \return List of all found wall crossings.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &plist, double t_max, const double,
+      const ParticleListView &plist, double t_max, const double,
       const std::vector<FourVector> &) const override;
 
   /// Ignore the neighbor searches for wall crossing
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, double,
+      const ParticleListView &, const ParticleListView &, double,
       const std::vector<FourVector> &) const override {
     return {};
   }
@@ -42,10 +42,6 @@ InterpolateData2DSpline::InterpolateData2DSpline(const std::vector<double>& x,
   const double* ya = &y[0];
   const double* za = &z[0];
 
-  // Create accelerator objects (interpolation lookups)
-  xacc_ = gsl_interp_accel_alloc();
-  yacc_ = gsl_interp_accel_alloc();
-
   // Initialize bicubic spline interpolation
   spline_ = gsl_spline2d_alloc(gsl_interp2d_bicubic, M, N);
   gsl_spline2d_init(spline_, xa, ya, za, M, N);
@@ -53,8 +49,6 @@ InterpolateData2DSpline::InterpolateData2DSpline(const std::vector<double>& x,
 
 InterpolateData2DSpline::~InterpolateData2DSpline() {
   gsl_spline2d_free(spline_);
-  gsl_interp_accel_free(xacc_);
-  gsl_interp_accel_free(yacc_);
 }
 
 double InterpolateData2DSpline::operator()(double xi, double yi) const {
@@ -64,8 +58,10 @@ double InterpolateData2DSpline::operator()(double xi, double yi) const {
   yi = (yi < first_y_) ? first_y_ : yi;
   yi = (yi > last_y_) ? last_y_ : yi;
 
-  // bicubic spline interpolation
-  return gsl_spline2d_eval(spline_, xi, yi, xacc_, yacc_);
+  /* bicubic spline interpolation; no accelerators are used, because they
+   * would be modified by every lookup and the object could not be shared
+   * between threads */
+  return gsl_spline2d_eval(spline_, xi, yi, nullptr, nullptr);
 }
 
 }  // namespace smash
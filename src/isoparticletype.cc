@@ -179,8 +179,8 @@ void IsoParticleType::create_multiplet(const ParticleType &type) {
   multiplet.add_state(type);
 }
 
-static Integrator integrate;
-static Integrator2d integrate2d;
+static thread_local Integrator integrate;
+static thread_local Integrator2d integrate2d;
 
 /**
  * Tabulation of all N R integrals.
@@ -263,6 +263,20 @@ inline void cache_integral(
   }
 }
 
+/**
+ * \return The tabulation of \p multiplet in \p tabulations, or nullptr if
+ * there is none.
+ *
+ * \param[in] tabulations Tabulations keyed by multiplet name.
+ * \param[in] multiplet Multiplet to look up.
+ */
+static Tabulation *find_tabulation(
+    std::unordered_map<std::string, Tabulation> &tabulations,
+    const IsoParticleType &multiplet) {
+  const auto found = tabulations.find(multiplet.name());
+  return found == tabulations.end() ? nullptr : &found->second;
+}
+
 void IsoParticleType::tabulate_integrals(sha256::Hash hash,
                                          const bf::path &tabulations_path) {
   // To avoid race conditions, make sure we are the only ones currently storing
@@ -299,6 +313,18 @@ void IsoParticleType::tabulate_integrals(sha256::Hash hash,
   if (rho && h1) {
     cache_integral(rhoR_tabulations, dir, hash, *rho, *h1, nullptr, true);
   }
+
+  /* Bind the tabulations to the multiplets right away, so that the lookups
+   * below only read and can be done concurrently by several threads. */
+  for (IsoParticleType &multiplet : iso_type_list) {
+    multiplet.XS_NR_tabulation_ = find_tabulation(NR_tabulations, multiplet);
+    multiplet.XS_piR_tabulation_ = find_tabulation(piR_tabulations, multiplet);
+    multiplet.XS_RK_tabulation_ = find_tabulation(RK_tabulations, multiplet);
+    multiplet.XS_DeltaR_tabulation_ =
+        find_tabulation(DeltaR_tabulations, multiplet);
+    multiplet.XS_rhoR_tabulation_ =
+        find_tabulation(rhoR_tabulations, multiplet);
+  }
 }
 
 double IsoParticleType::get_integral_NR(double sqrts) {
@@ -26,6 +26,10 @@
 
 namespace smash {
 
+/* The interpolations of PDG data below are function-local statics. They are
+ * built on first use, which is guaranteed to happen exactly once even if
+ * several threads call the function concurrently, and only read afterwards. */
+
 double xs_high_energy(double mandelstam_s, bool is_opposite_charge, double ma,
                       double mb, double P, double R1, double R2) {
   const double M = 2.1206;
@@ -105,16 +109,16 @@ double pipi_string_hard(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 static double piplusp_elastic_pdg(double mandelstam_s) {
-  if (piplusp_elastic_interpolation == nullptr) {
-    std::vector<double> x = PIPLUSP_ELASTIC_P_LAB;
-    std::vector<double> y = PIPLUSP_ELASTIC_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    piplusp_elastic_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      piplusp_elastic_interpolation = [] {
+        std::vector<double> x = PIPLUSP_ELASTIC_P_LAB;
+        std::vector<double> y = PIPLUSP_ELASTIC_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
   return (*piplusp_elastic_interpolation)(p_lab);
 }
@@ -149,15 +153,15 @@ double piplusp_elastic(double mandelstam_s) {
   }
 
   // The elastic contributions from decays still need to be subtracted.
-  if (piplusp_elastic_res_interpolation == nullptr) {
-    std::vector<double> x = PIPLUSP_RES_SQRTS;
-    for (auto& i : x) {
-      i = i * i;
-    }
-    std::vector<double> y = PIPLUSP_RES_SIG;
-    piplusp_elastic_res_interpolation =
-        make_unique<InterpolateDataSpline>(x, y);
-  }
+  static const std::unique_ptr<InterpolateDataSpline>
+      piplusp_elastic_res_interpolation = [] {
+        std::vector<double> x = PIPLUSP_RES_SQRTS;
+        for (auto& i : x) {
+          i = i * i;
+        }
+        std::vector<double> y = PIPLUSP_RES_SIG;
+        return make_unique<InterpolateDataSpline>(x, y);
+      }();
   sigma -= (*piplusp_elastic_res_interpolation)(mandelstam_s);
   if (sigma < 0) {
     sigma = really_small;
@@ -171,16 +175,16 @@ double piplusp_elastic(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 double piplusp_sigmapluskplus_pdg(double mandelstam_s) {
-  if (piplusp_sigmapluskplus_interpolation == nullptr) {
-    std::vector<double> x = PIPLUSP_SIGMAPLUSKPLUS_P_LAB;
-    std::vector<double> y = PIPLUSP_SIGMAPLUSKPLUS_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 5);
-    piplusp_sigmapluskplus_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      piplusp_sigmapluskplus_interpolation = [] {
+        std::vector<double> x = PIPLUSP_SIGMAPLUSKPLUS_P_LAB;
+        std::vector<double> y = PIPLUSP_SIGMAPLUSKPLUS_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.2, 5);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
   return (*piplusp_sigmapluskplus_interpolation)(p_lab);
 }
@@ -191,16 +195,16 @@ double piplusp_sigmapluskplus_pdg(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 static double piminusp_elastic_pdg(double mandelstam_s) {
-  if (piminusp_elastic_interpolation == nullptr) {
-    std::vector<double> x = PIMINUSP_ELASTIC_P_LAB;
-    std::vector<double> y = PIMINUSP_ELASTIC_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_elastic_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      piminusp_elastic_interpolation = [] {
+        std::vector<double> x = PIMINUSP_ELASTIC_P_LAB;
+        std::vector<double> y = PIMINUSP_ELASTIC_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
   return (*piminusp_elastic_interpolation)(p_lab);
 }
@@ -227,18 +231,18 @@ double piminusp_elastic(double mandelstam_s) {
               0.88);
   }
   // The elastic contributions from decays still need to be subtracted.
-  if (piminusp_elastic_res_interpolation == nullptr) {
-    std::vector<double> x = PIMINUSP_RES_SQRTS;
-    for (auto& i : x) {
-      i = i * i;
-    }
-    std::vector<double> y = PIMINUSP_RES_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    piminusp_elastic_res_interpolation =
-        make_unique<InterpolateDataSpline>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataSpline>
+      piminusp_elastic_res_interpolation = [] {
+        std::vector<double> x = PIMINUSP_RES_SQRTS;
+        for (auto& i : x) {
+          i = i * i;
+        }
+        std::vector<double> y = PIMINUSP_RES_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        return make_unique<InterpolateDataSpline>(dedup_x, dedup_y);
+      }();
   sigma -= (*piminusp_elastic_res_interpolation)(mandelstam_s);
   if (sigma < 0) {
     sigma = really_small;
@@ -252,16 +256,16 @@ double piminusp_elastic(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 double piminusp_lambdak0_pdg(double mandelstam_s) {
-  if (piminusp_lambdak0_interpolation == nullptr) {
-    std::vector<double> x = PIMINUSP_LAMBDAK0_P_LAB;
-    std::vector<double> y = PIMINUSP_LAMBDAK0_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_lambdak0_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      piminusp_lambdak0_interpolation = [] {
+        std::vector<double> x = PIMINUSP_LAMBDAK0_P_LAB;
+        std::vector<double> y = PIMINUSP_LAMBDAK0_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
   return (*piminusp_lambdak0_interpolation)(p_lab);
 }
@@ -272,16 +276,16 @@ double piminusp_lambdak0_pdg(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 double piminusp_sigmaminuskplus_pdg(double mandelstam_s) {
-  if (piminusp_sigmaminuskplus_interpolation == nullptr) {
-    std::vector<double> x = PIMINUSP_SIGMAMINUSKPLUS_P_LAB;
-    std::vector<double> y = PIMINUSP_SIGMAMINUSKPLUS_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_sigmaminuskplus_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      piminusp_sigmaminuskplus_interpolation = [] {
+        std::vector<double> x = PIMINUSP_SIGMAMINUSKPLUS_P_LAB;
+        std::vector<double> y = PIMINUSP_SIGMAMINUSKPLUS_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
   return (*piminusp_sigmaminuskplus_interpolation)(p_lab);
 }
@@ -292,16 +296,16 @@ double piminusp_sigmaminuskplus_pdg(double mandelstam_s) {
  * cross section was given for one sqrts value, the corresponding cross sections
  * are averaged. */
 double piminusp_sigma0k0_res(double mandelstam_s) {
-  if (piminusp_sigma0k0_interpolation == nullptr) {
-    std::vector<double> x = PIMINUSP_SIGMA0K0_RES_SQRTS;
-    std::vector<double> y = PIMINUSP_SIGMA0K0_RES_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_sigma0k0_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      piminusp_sigma0k0_interpolation = [] {
+        std::vector<double> x = PIMINUSP_SIGMA0K0_RES_SQRTS;
+        std::vector<double> y = PIMINUSP_SIGMA0K0_RES_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double sqrts = std::sqrt(mandelstam_s);
   return (*piminusp_sigma0k0_interpolation)(sqrts);
 }
@@ -448,16 +452,16 @@ double kplusn_k0p(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 static double kminusp_elastic_pdg(double mandelstam_s) {
-  if (kminusp_elastic_interpolation == nullptr) {
-    std::vector<double> x = KMINUSP_ELASTIC_P_LAB;
-    std::vector<double> y = KMINUSP_ELASTIC_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    kminusp_elastic_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      kminusp_elastic_interpolation = [] {
+        std::vector<double> x = KMINUSP_ELASTIC_P_LAB;
+        std::vector<double> y = KMINUSP_ELASTIC_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
   return (*kminusp_elastic_interpolation)(p_lab);
 }
@@ -484,15 +488,15 @@ double kminusp_elastic_background(double mandelstam_s) {
     sigma = kminusp_elastic_pdg(mandelstam_s);
   }
   // The elastic contributions from decays still need to be subtracted.
-  if (kminusp_elastic_res_interpolation == nullptr) {
-    std::vector<double> x = KMINUSP_RES_SQRTS;
-    for (auto& i : x) {
-      i = plab_from_s(i * i, kaon_mass, nucleon_mass);
-    }
-    std::vector<double> y = KMINUSP_RES_SIG;
-    kminusp_elastic_res_interpolation =
-        make_unique<InterpolateDataSpline>(x, y);
-  }
+  static const std::unique_ptr<InterpolateDataSpline>
+      kminusp_elastic_res_interpolation = [] {
+        std::vector<double> x = KMINUSP_RES_SQRTS;
+        for (auto& i : x) {
+          i = plab_from_s(i * i, kaon_mass, nucleon_mass);
+        }
+        std::vector<double> y = KMINUSP_RES_SIG;
+        return make_unique<InterpolateDataSpline>(x, y);
+      }();
   const auto old_sigma = sigma;
   sigma -= (*kminusp_elastic_res_interpolation)(p_lab);
   if (sigma < 0) {
@@ -529,32 +533,32 @@ double kbar0n_elastic_background(double mandelstam_s) {
 }
 
 double kplusp_inelastic_background(double mandelstam_s) {
-  if (kplusp_total_interpolation == nullptr) {
-    std::vector<double> x = KPLUSP_TOT_PLAB;
-    std::vector<double> y = KPLUSP_TOT_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    kplusp_total_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      kplusp_total_interpolation = [] {
+        std::vector<double> x = KPLUSP_TOT_PLAB;
+        std::vector<double> y = KPLUSP_TOT_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
   return (*kplusp_total_interpolation)(p_lab)-kplusp_elastic_background(
       mandelstam_s);
 }
 
 double kplusn_inelastic_background(double mandelstam_s) {
-  if (kplusn_total_interpolation == nullptr) {
-    std::vector<double> x = KPLUSN_TOT_PLAB;
-    std::vector<double> y = KPLUSN_TOT_SIG;
-    std::vector<double> dedup_x;
-    std::vector<double> dedup_y;
-    std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
-    dedup_y = smooth(dedup_x, dedup_y, 0.05, 5);
-    kplusn_total_interpolation =
-        make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
+  static const std::unique_ptr<InterpolateDataLinear<double>>
+      kplusn_total_interpolation = [] {
+        std::vector<double> x = KPLUSN_TOT_PLAB;
+        std::vector<double> y = KPLUSN_TOT_SIG;
+        std::vector<double> dedup_x;
+        std::vector<double> dedup_y;
+        std::tie(dedup_x, dedup_y) = dedup_avg(x, y);
+        dedup_y = smooth(dedup_x, dedup_y, 0.05, 5);
+        return make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
+      }();
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
   return (*kplusn_total_interpolation)(p_lab)-kplusn_elastic_background(
              mandelstam_s) -
@@ -664,7 +668,7 @@ double KaonNucleonRatios::get_ratio(const ParticleType& a,
   return ratios_.at(key);
 }
 
-/*thread_local (see #3075)*/ KaonNucleonRatios kaon_nucleon_ratios;
+thread_local KaonNucleonRatios kaon_nucleon_ratios;
 
 double kminusp_kbar0n(double mandelstam_s) {
   constexpr double a0 = 100;   // mb GeV^2
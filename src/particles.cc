@@ -9,6 +9,7 @@
 
 #include "smash/particles.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
@@ -145,6 +146,15 @@ void Particles::reset() {
   dirty_.clear();
 }
 
+void Particles::copy_from(const Particles &other) {
+  id_max_ = other.id_max_;
+  data_size_ = other.data_size_;
+  data_capacity_ = other.data_capacity_;
+  data_.reset(new ParticleData[data_capacity_]);
+  std::copy(&other.data_[0], &other.data_[data_capacity_], &data_[0]);
+  dirty_ = other.dirty_;
+}
+
 std::ostream &operator<<(std::ostream &out, const Particles &particles) {
   out << particles.size() << " Particles:\n";
   for (unsigned i = 0; i < particles.data_size_; ++i) {
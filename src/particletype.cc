@@ -11,9 +11,14 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <map>
+#include <tuple>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
@@ -26,6 +31,7 @@
 #include "smash/logging.h"
 #include "smash/potential_globals.h"
 #include "smash/stringfunctions.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LParticleType = LogArea::ParticleType::id;
@@ -426,15 +432,30 @@ const DecayModes &ParticleType::decay_modes() const {
   return modes;
 }
 
+double ParticleType::mode_width(double m, std::size_t i) const {
+  const DecayBranch *mode = decay_modes().decay_mode_list()[i].get();
+  if (m < mode->threshold()) {
+    return 0.;
+  }
+  if (width_tabulations_ && m <= (*width_tabulations_)[i + 1].x_max()) {
+    return (*width_tabulations_)[i + 1].get_value_linear(m);
+  }
+  return partial_width(m, mode);
+}
+
 double ParticleType::total_width(const double m) const {
   double w = 0.;
   if (is_stable()) {
     return w;
   }
-  /* Loop over decay modes and sum up all partial widths. */
-  const auto &modes = decay_modes().decay_mode_list();
-  for (unsigned int i = 0; i < modes.size(); i++) {
-    w = w + partial_width(m, modes[i].get());
+  if (width_tabulations_ && m <= width_tabulations_->front().x_max()) {
+    w = width_tabulations_->front().get_value_linear(m);
+  } else {
+    /* Loop over decay modes and sum up all partial widths. */
+    const auto &modes = decay_modes().decay_mode_list();
+    for (unsigned int i = 0; i < modes.size(); i++) {
+      w = w + partial_width(m, modes[i].get());
+    }
   }
   if (w < width_cutoff) {
     return 0.;
@@ -442,6 +463,175 @@ double ParticleType::total_width(const double m) const {
   return w;
 }
 
+/**
+ * Reads tabulations from a cache file.
+ *
+ * \param[in] path Cache file, nothing is read if empty.
+ * \param[in] hash Hash identifying valid cached tabulations.
+ * \param[in] n Number of tabulations in the file.
+ * \return The \p n tabulations, or an empty list if the file does not exist
+ * or does not match.
+ */
+static std::vector<Tabulation> read_tabulations(const bf::path &path,
+                                                sha256::Hash hash,
+                                                std::size_t n) {
+  std::vector<Tabulation> tables;
+  if (path.empty() || !bf::exists(path)) {
+    return tables;
+  }
+  std::ifstream file(path.string());
+  for (std::size_t i = 0; i < n; ++i) {
+    Tabulation stored = Tabulation::from_file(file, hash);
+    if (stored.is_empty() || !file) {
+      return {};
+    }
+    tables.emplace_back(std::move(stored));
+  }
+  return tables;
+}
+
+/**
+ * Writes tabulations to a cache file. They are written to a temporary file
+ * first, such that concurrent readers never see incomplete tabulations.
+ *
+ * \param[in] path Cache file, nothing is written if empty.
+ * \param[in] hash Hash identifying the tabulations.
+ * \param[in] tables Tabulations to be written.
+ */
+static void write_tabulations(const bf::path &path, sha256::Hash hash,
+                              const std::vector<const Tabulation *> &tables) {
+  if (path.empty()) {
+    return;
+  }
+  const bf::path temporary =
+      path.parent_path() /
+      bf::unique_path(path.stem().string() + "_%%%%-%%%%-%%%%.tmp");
+  {
+    std::ofstream file(temporary.string());
+    for (const Tabulation *table : tables) {
+      table->write(file, hash);
+    }
+  }
+  bf::rename(temporary, path);
+}
+
+/**
+ * Creates the width tabulations of an unstable \p type, see
+ * ParticleType::tabulate_widths, or reads them from \p path.
+ *
+ * \param[in] type The unstable type.
+ * \param[in] hash Hash identifying valid cached tabulations.
+ * \param[in] path File of the cached tabulations, no caching if empty.
+ * \return The total width followed by the partial widths of all modes.
+ */
+static std::vector<Tabulation> tabulate_type_widths(const ParticleType &type,
+                                                    sha256::Hash hash,
+                                                    const bf::path &path) {
+  const auto &modes = type.decay_modes().decay_mode_list();
+  std::vector<Tabulation> tables =
+      read_tabulations(path, hash, modes.size() + 1);
+  if (!tables.empty()) {
+    return tables;
+  }
+
+  constexpr double spacing = 0.001;
+  double m_min = type.mass();
+  for (const auto &mode : modes) {
+    m_min = std::min(m_min, mode->threshold());
+  }
+  const double range =
+      type.mass() - m_min + std::max(2., 10. * type.width_at_pole());
+  const std::size_t n = std::ceil(range / spacing);
+  /* All tabulations share the same grid, so the interpolated total width is
+   * the sum of the interpolated partial widths. */
+  std::vector<std::vector<double>> partial(modes.size());
+  for (std::size_t i = 0; i < modes.size(); ++i) {
+    partial[i].resize(n + 1);
+    for (std::size_t k = 0; k <= n; ++k) {
+      partial[i][k] = type.partial_width(m_min + k * range / n, modes[i].get());
+    }
+  }
+  tables.emplace_back(m_min, range, n, [&](double m) {
+    const std::size_t k = std::round((m - m_min) * n / range);
+    double w = 0.;
+    for (const auto &values : partial) {
+      w += values[k];
+    }
+    return w;
+  });
+  for (const auto &values : partial) {
+    tables.emplace_back(m_min, range, n, [&](double m) {
+      return values[std::round((m - m_min) * n / range)];
+    });
+  }
+
+  std::vector<const Tabulation *> pointers;
+  for (const Tabulation &table : tables) {
+    pointers.push_back(&table);
+  }
+  write_tabulations(path, hash, pointers);
+  return tables;
+}
+
+void ParticleType::tabulate_widths(sha256::Hash hash,
+                                   const bf::path &tabulations_path) {
+  // The layout of the tabulations is part of what they depend on.
+  sha256::Context hash_context;
+  hash_context.update(sha256::hash_to_string(hash));
+  hash_context.update("widths: 1 MeV spacing, 2 GeV or 10 widths above pole");
+  const sha256::Hash widths_hash = hash_context.finalize();
+  for (const ParticleType &type : list_all()) {
+    if (type.is_stable()) {
+      continue;
+    }
+    const bf::path path =
+        tabulations_path.empty()
+            ? bf::path()
+            : tabulations_path / ("Widths_" + type.pdgcode().string() + ".bin");
+    type.width_tabulations_ = std::make_shared<const std::vector<Tabulation>>(
+        tabulate_type_widths(type, widths_hash, path));
+  }
+}
+
+void ParticleType::tabulate_spectral_functions(
+    sha256::Hash hash, const bf::path &tabulations_path) {
+  // The layout of the tabulations is part of what they depend on.
+  sha256::Context hash_context;
+  hash_context.update(sha256::hash_to_string(hash));
+  hash_context.update(
+      "spectral functions: 1 MeV spacing, 2 GeV or 10 widths above pole");
+  const sha256::Hash spectral_hash = hash_context.finalize();
+  constexpr double spacing = 0.001;
+  for (const ParticleType &type : list_all()) {
+    if (type.is_stable()) {
+      continue;
+    }
+    const bf::path path = tabulations_path.empty()
+                              ? bf::path()
+                              : tabulations_path / ("SpectralFunction_" +
+                                                    type.pdgcode().string() +
+                                                    ".bin");
+    std::vector<Tabulation> stored = read_tabulations(path, spectral_hash, 1);
+    if (!stored.empty()) {
+      type.mass_tabulation_ = std::make_shared<const InverseCdfTabulation>(
+          std::move(stored.front()));
+    } else {
+      const double m_min = type.min_mass_spectral();
+      const double range =
+          type.mass() - m_min + std::max(2., 10. * type.width_at_pole());
+      const std::size_t n = std::ceil(range / spacing);
+      auto table = std::make_shared<const InverseCdfTabulation>(
+          m_min, range, n,
+          [&type](double m) { return type.spectral_function(m); });
+      write_tabulations(path, spectral_hash, {table.get()});
+      type.mass_tabulation_ = std::move(table);
+    }
+    // the sampled distribution changed
+    type.spectral_ratio_bounds_ = nullptr;
+    type.tabulate_spectral_ratio_bounds();
+  }
+}
+
 void ParticleType::check_consistency() {
   for (const ParticleType &ptype : ParticleType::list_all()) {
     if (!ptype.is_stable() && ptype.decay_modes().is_empty()) {
@@ -453,7 +643,7 @@ void ParticleType::check_consistency() {
 
 bool ParticleType::wanted_decaymode(const DecayType &t,
                                     WhichDecaymodes wh) const {
-  const auto FinalTypes = t.particle_types();
+  const auto &FinalTypes = t.particle_types();
   switch (wh) {
     case WhichDecaymodes::All: {
       return true;
@@ -483,14 +673,16 @@ bool ParticleType::wanted_decaymode(const DecayType &t,
   }
 }
 
-DecayBranchList ParticleType::get_partial_widths(const FourVector p,
-                                                 const ThreeVector x,
-                                                 WhichDecaymodes wh) const {
+void ParticleType::get_partial_widths(const FourVector p, const ThreeVector x,
+                                      WhichDecaymodes wh,
+                                      DecayWidths *widths) const {
   const auto &decay_mode_list = decay_modes().decay_mode_list();
   if (decay_mode_list.size() == 0 ||
       (wh == WhichDecaymodes::Hadronic && is_stable())) {
-    return {};
+    widths->reset(0);
+    return;
   }
+  widths->reset(decay_mode_list.size());
   /* Determine whether the decay is affected by the potentials. If it's
    * affected, read the values of the potentials at the position of the
    * particle */
@@ -503,11 +695,12 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
     UI3_lat_pointer->value_at(x, UI3);
   }
   /* Loop over decay modes and calculate all partial widths. */
-  DecayBranchList partial;
-  partial.reserve(decay_mode_list.size());
   for (unsigned int i = 0; i < decay_mode_list.size(); i++) {
+    if (!wanted_decaymode(decay_mode_list[i]->type(), wh)) {
+      continue;
+    }
     /* Calculate the sqare root s of the final state particles. */
-    const auto FinalTypes = decay_mode_list[i]->type().particle_types();
+    const auto &FinalTypes = decay_mode_list[i]->type().particle_types();
     double scale_B = 0.0;
     double scale_I3 = 0.0;
     if (pot_pointer != nullptr) {
@@ -521,12 +714,25 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
     }
     double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
 
-    const double w = partial_width(sqrt_s, decay_mode_list[i].get());
+    const double w = mode_width(sqrt_s, i);
     if (w > 0.) {
-      if (wanted_decaymode(decay_mode_list[i]->type(), wh)) {
-        partial.push_back(
-            make_unique<DecayBranch>(decay_mode_list[i]->type(), w));
-      }
+      widths->set(i, w);
+    }
+  }
+}
+
+DecayBranchList ParticleType::get_partial_widths(const FourVector p,
+                                                 const ThreeVector x,
+                                                 WhichDecaymodes wh) const {
+  DecayWidths widths;
+  get_partial_widths(p, x, wh, &widths);
+  const auto &decay_mode_list = decay_modes().decay_mode_list();
+  DecayBranchList partial;
+  partial.reserve(widths.number_of_open_modes());
+  for (std::size_t i = 0; i < widths.size(); i++) {
+    if (widths[i] > 0.) {
+      partial.push_back(
+          make_unique<DecayBranch>(decay_mode_list[i]->type(), widths[i]));
     }
   }
   return partial;
@@ -539,10 +745,13 @@ double ParticleType::get_partial_width(const double m,
 
   /* Find the right one(s) and add up corresponding widths. */
   double w = 0.;
-  for (const auto &mode : decaymodes) {
-    double partial_width_at_pole = width_at_pole() * mode->weight();
-    if (mode->type().has_particles(dlist)) {
-      w += mode->type().width(mass(), partial_width_at_pole, m);
+  for (std::size_t i = 0; i < decaymodes.size(); ++i) {
+    if (decaymodes[i]->type().has_particles(dlist)) {
+      w += width_tabulations_ ? mode_width(m, i)
+                              : decaymodes[i]->type().width(
+                                    mass(),
+                                    width_at_pole() * decaymodes[i]->weight(),
+                                    m);
     }
   }
   return w;
@@ -571,7 +780,7 @@ double ParticleType::spectral_function(double m) const {
   if (norm_factor_ < 0.) {
     /* Initialize the normalization factor
      * by integrating over the unnormalized spectral function. */
-    static /*thread_local (see #3075)*/ Integrator integrate;
+    static thread_local Integrator integrate;
     const double width = width_at_pole();
     const double m_pole = mass();
     // We transform the integral using m = m_min + width_pole * tan(x), to
@@ -612,6 +821,114 @@ double ParticleType::spectral_function_simple(double m) const {
 }
 
 /* Resonance mass sampling for 2-particle final state */
+/**
+ * \return The unnormalized Cauchy distribution that random::cauchy samples.
+ *
+ * \param[in] x Argument of the distribution.
+ * \param[in] pole Location of the peak.
+ * \param[in] width Half width at half maximum.
+ */
+static double cauchy_shape(double x, double pole, double width) {
+  const double z = (x - pole) / width;
+  return 1. / (1. + z * z);
+}
+
+double ParticleType::mass_tail_factor() const {
+  const InverseCdfTabulation &table = *mass_tabulation_;
+  return table.get_value_linear(table.x_max()) /
+         cauchy_shape(table.x_max(), mass(), width_at_pole() / 2.);
+}
+
+std::pair<double, double> ParticleType::sample_spectral_mass(
+    double max_mass) const {
+  const double pole = mass();
+  const double half_width = width_at_pole() / 2.;
+  if (!mass_tabulation_) {
+    // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
+    const double m =
+        random::cauchy(pole, half_width, min_mass_spectral(), max_mass);
+    return {m, spectral_ratio(m)};
+  }
+  /* Sample from the tabulated spectral function, continued by a Cauchy tail
+   * above the tabulation. */
+  const InverseCdfTabulation &table = *mass_tabulation_;
+  const double weight_table = table.cumulative(max_mass);
+  double weight_tail = 0.;
+  if (max_mass > table.x_max()) {
+    weight_tail = mass_tail_factor() * half_width *
+                  (std::atan((max_mass - pole) / half_width) -
+                   std::atan((table.x_max() - pole) / half_width));
+  }
+  double m;
+  if (random::uniform(0., weight_table + weight_tail) < weight_table) {
+    m = table.inverse(random::uniform(0., weight_table));
+  } else {
+    m = random::cauchy(pole, half_width, table.x_max(), max_mass);
+  }
+  return {m, spectral_ratio(m)};
+}
+
+double ParticleType::spectral_ratio(double m) const {
+  if (!mass_tabulation_) {
+    return spectral_function(m) / spectral_function_simple(m);
+  }
+  const InverseCdfTabulation &table = *mass_tabulation_;
+  const double density =
+      m <= table.x_max()
+          ? table.density(m)
+          : mass_tail_factor() * cauchy_shape(m, mass(), width_at_pole() / 2.);
+  return density > 0. ? spectral_function(m) / density : 0.;
+}
+
+void ParticleType::tabulate_spectral_ratio_bounds() const {
+  if (is_stable() || spectral_ratio_bounds_) {
+    return;
+  }
+  /* Same grid as the widths and spectral functions. The ratio is evaluated at
+   * several points per interval, and the bound at every grid point also
+   * covers the following interval, such that the nearest grid point of any
+   * mass gives a bound for all masses below. */
+  constexpr double spacing = 0.001;
+  constexpr int points_per_interval = 4;
+  const double m_min = min_mass_spectral();
+  const double range = mass() - m_min + std::max(2., 10. * width_at_pole());
+  const std::size_t n = std::ceil(range / spacing);
+  const double dx = range / n;
+  std::vector<double> running_max(n + 1);
+  double ratio_max = spectral_ratio(m_min);
+  for (std::size_t k = 0; k <= n; ++k) {
+    for (int i = 1; i <= points_per_interval; ++i) {
+      const double m = m_min + k * dx + i * dx / points_per_interval;
+      ratio_max = std::max(ratio_max, spectral_ratio(m));
+    }
+    running_max[k] = ratio_max;
+  }
+  spectral_ratio_bounds_ = std::make_shared<const Tabulation>(
+      m_min, range, n, [&](double m) {
+        return running_max[std::round((m - m_min) / dx)];
+      });
+}
+
+double ParticleType::spectral_ratio_bound(double max_mass) const {
+  if (spectral_ratio_bounds_) {
+    const Tabulation &bounds = *spectral_ratio_bounds_;
+    double bound = bounds.get_value_step(max_mass);
+    if (max_mass > bounds.x_max()) {
+      /* Above the tabulation, the maximum of the ratio 'usually' is at the
+       * largest mass. */
+      bound = std::max(bound, spectral_ratio(max_mass));
+    }
+    return bound > 0. ? bound : 1.;
+  }
+  /* The ratio of the spectral function to the sampled distribution 'usually'
+   * is largest at the largest mass. Within the tabulation, the ratio is
+   * close to 1. */
+  if (mass_tabulation_ && max_mass <= mass_tabulation_->x_max()) {
+    return 1.;
+  }
+  return std::max(1., spectral_ratio(max_mass));
+}
+
 double ParticleType::sample_resonance_mass(const double mass_stable,
                                            const double cms_energy,
                                            int L) const {
@@ -625,31 +942,26 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
   // largest possible cm momentum (from smallest mass)
   const double pcm_max = pCM(cms_energy, mass_stable, min_mass);
   const double blw_max = pcm_max * blatt_weisskopf_sqr(pcm_max, L);
-  /* The maximum of the spectral-function ratio 'usually' happens at the
-   * largest mass. However, this is not always the case, therefore we need
-   * and additional fudge factor (determined automatically). Additionally,
-   * a heuristic knowledge is used that usually such mass exist that
-   * spectral_function(m) > spectral_function_simple(m). */
-  const double sf_ratio_max =
-      std::max(1., this->spectral_function(max_mass) /
-                       this->spectral_function_simple(max_mass));
+  /* Bound of the spectral-function ratio. If it is exceeded nevertheless,
+   * it is increased for this sampling only, such that the sampling does not
+   * depend on earlier ones. */
+  const double sf_ratio_max = spectral_ratio_bound(max_mass);
+  double max_factor = 1.;
 
   double mass_res, val;
   // outer loop: repeat if maximum is too small
   do {
-    const double q_max = sf_ratio_max * this->max_factor1_;
+    const double q_max = sf_ratio_max * max_factor;
     const double max = blw_max * q_max;  // maximum value for rejection sampling
     // inner loop: rejection sampling
     do {
-      // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
-      mass_res = random::cauchy(this->mass(), this->width_at_pole() / 2.,
-                                this->min_mass_spectral(), max_mass);
+      /* sample mass from the tabulated spectral function or a simple
+       * Breit-Wigner, q is the ratio of the full spectral function to it */
+      double q;
+      std::tie(mass_res, q) = sample_spectral_mass(max_mass);
       // determine cm momentum for this case
       const double pcm = pCM(cms_energy, mass_stable, mass_res);
       const double blw = pcm * blatt_weisskopf_sqr(pcm, L);
-      // determine ratio of full to simple spectral function
-      const double q = this->spectral_function(mass_res) /
-                       this->spectral_function_simple(mass_res);
       val = q * blw;
     } while (val < random::uniform(0., max));
 
@@ -657,9 +969,9 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_mass: ",
-          this->max_factor1_, " ", val / max, " ", this->pdgcode(), " ",
-          mass_stable, " ", cms_energy, " ", mass_res);
-      this->max_factor1_ *= val / max;
+          max_factor, " ", val / max, " ", this->pdgcode(), " ", mass_stable,
+          " ", cms_energy, " ", mass_res);
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -682,36 +994,36 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
   const double pcm_max =
       pCM(cms_energy, t1.min_mass_spectral(), t2.min_mass_spectral());
   const double blw_max = pcm_max * blatt_weisskopf_sqr(pcm_max, L);
+  const double sf_ratio_max = t1.spectral_ratio_bound(max_mass_1) *
+                              t2.spectral_ratio_bound(max_mass_2);
+  // increased for this sampling only, if the bound turns out to be too small
+  double max_factor = 1.;
 
   double mass_1, mass_2, val;
   // outer loop: repeat if maximum is too small
   do {
-    // maximum value for rejection sampling (determined automatically)
-    const double max = blw_max * t1.max_factor2_;
+    // maximum value for rejection sampling
+    const double max = blw_max * sf_ratio_max * max_factor;
     // inner loop: rejection sampling
     do {
-      // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
-      mass_1 = random::cauchy(t1.mass(), t1.width_at_pole() / 2.,
-                              t1.min_mass_spectral(), max_mass_1);
-      mass_2 = random::cauchy(t2.mass(), t2.width_at_pole() / 2.,
-                              t2.min_mass_spectral(), max_mass_2);
+      /* sample masses from the tabulated spectral functions or simple
+       * Breit-Wigners, q1 and q2 are the ratios of the full spectral
+       * functions to them */
+      double q1, q2;
+      std::tie(mass_1, q1) = t1.sample_spectral_mass(max_mass_1);
+      std::tie(mass_2, q2) = t2.sample_spectral_mass(max_mass_2);
       // determine cm momentum for this case
       const double pcm = pCM(cms_energy, mass_1, mass_2);
       const double blw = pcm * blatt_weisskopf_sqr(pcm, L);
-      // determine ratios of full to simple spectral function
-      const double q1 =
-          t1.spectral_function(mass_1) / t1.spectral_function_simple(mass_1);
-      const double q2 =
-          t2.spectral_function(mass_2) / t2.spectral_function_simple(mass_2);
       val = q1 * q2 * blw;
     } while (val < random::uniform(0., max));
 
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_masses: ",
-          t1.max_factor2_, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
+          max_factor, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
           " ", cms_energy, " ", mass_1, " ", mass_2);
-      t1.max_factor2_ *= val / max;
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -8,6 +8,9 @@
  */
 
 #include "smash/pauliblocking.h"
+
+#include <cmath>
+
 #include "smash/constants.h"
 #include "smash/logging.h"
 
@@ -64,51 +67,161 @@ PauliBlocker::PauliBlocker(Configuration conf,
 
 PauliBlocker::~PauliBlocker() {}
 
+void PauliBlocker::add_to_density(const ParticleData &part,
+                                  const ThreeVector &r, const ThreeVector &p,
+                                  const PdgCode pdg,
+                                  const ParticleList &disregard,
+                                  double &f) const {
+  // Only consider identical particles
+  if (part.pdgcode() != pdg) {
+    return;
+  }
+  // Only consider momenta in sphere of radius rp_ with center at p
+  const double pdist_sqr = (part.momentum().threevec() - p).sqr();
+  if (pdist_sqr > rp_ * rp_) {
+    return;
+  }
+  const double rdist_sqr = (part.position().threevec() - r).sqr();
+  // Only consider coordinates in sphere of radius rr_+rc_ with center at r
+  if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
+    return;
+  }
+  // Do not count particles that should be disregarded.
+  for (const auto &disregard_part : disregard) {
+    if (part.id() == disregard_part.id()) {
+      return;
+    }
+  }
+  // 1st order interpolation using tabulated values
+  const double i_real = std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
+  const size_t i = std::floor(i_real);
+  const double rest = i_real - i;
+  if (likely(i + 1 < weights_.size())) {
+    f += weights_[i] * rest + weights_[i + 1] * (1. - rest);
+  }
+}
+
 double PauliBlocker::phasespace_dens(const ThreeVector &r, const ThreeVector &p,
                                      const Particles &particles,
                                      const PdgCode pdg,
                                      const ParticleList &disregard) const {
   double f = 0.0;
 
-  /* TODO(oliiny): looping over all particles is inefficient,
-   * I need only particles within rp_ radius in momentum and
-   * within rr_+rc_ in coordinate space. Some search algorithm might help. */
-  for (const auto &part : particles) {
-    // Only consider identical particles
-    if (part.pdgcode() != pdg) {
-      continue;
+  if (&particles != indexed_particles_ || !pdg.is_baryon()) {
+    for (const auto &part : particles) {
+      add_to_density(part, r, p, pdg, disregard, f);
     }
-    // Only consider momenta in sphere of radius rp_ with center at p
-    const double pdist_sqr = (part.momentum().threevec() - p).sqr();
-    if (pdist_sqr > rp_ * rp_) {
-      continue;
-    }
-    const double rdist_sqr = (part.position().threevec() - r).sqr();
-    // Only consider coordinates in sphere of radius rr_+rc_ with center at r
-    if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
-      continue;
-    }
-    // Do not count particles that should be disregarded.
-    bool to_disregard = false;
-    for (const auto &disregard_part : disregard) {
-      if (part.id() == disregard_part.id()) {
-        to_disregard = true;
+    return f / ntest_;
+  }
+
+  /* Only visit the cells that overlap with the sphere of radius rr_+rc_
+   * (plus the displacement since indexing, i.e. index_dr_) around r and the
+   * sphere of radius rp_ around p. The cells are as large as these radii. */
+  std::array<int, 6> lower, upper;
+  for (int k = 0; k < 3; k++) {
+    lower[k] = std::floor((r[k] - index_dr_) / index_dr_);
+    upper[k] = std::floor((r[k] + index_dr_) / index_dr_);
+    lower[k + 3] = std::floor((p[k] - rp_) / rp_);
+    upper[k + 3] = std::floor((p[k] + rp_) / rp_);
+  }
+  std::array<int, 6> cell = lower;
+  while (true) {
+    const auto found = index_.find(cell_key(pdg, cell));
+    if (found != index_.end()) {
+      for (const ParticleData &copy : found->second) {
+        // cells may share a key, so particles might show up more than once
+        if (cell_of(copy) == cell && particles.is_valid(copy)) {
+          add_to_density(particles.lookup(copy), r, p, pdg, disregard, f);
+        }
       }
     }
-    if (to_disregard) {
-      continue;
+    // next cell
+    int k = 0;
+    while (k < 6 && cell[k] == upper[k]) {
+      cell[k] = lower[k];
+      k++;
     }
-    // 1st order interpolation using tabulated values
-    const double i_real = std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
-    const size_t i = std::floor(i_real);
-    const double rest = i_real - i;
-    if (likely(i + 1 < weights_.size())) {
-      f += weights_[i] * rest + weights_[i + 1] * (1. - rest);
+    if (k == 6) {
+      break;
     }
+    cell[k]++;
   }
   return f / ntest_;
 }
 
+std::uint64_t PauliBlocker::cell_key(const PdgCode pdg,
+                                     const std::array<int, 6> &cell) {
+  // 10 bits per coordinate, distant cells may share a key
+  std::uint64_t key = 0;
+  for (const int c : cell) {
+    key = (key << 10) | (static_cast<std::uint64_t>(c) & 0x3ff);
+  }
+  const auto code = static_cast<std::uint64_t>(pdg.get_decimal());
+  return key ^ (code * 0x9e3779b97f4a7c15ull);
+}
+
+std::array<int, 6> PauliBlocker::cell_of(const ParticleData &part) const {
+  const ThreeVector r = part.position().threevec();
+  const ThreeVector p = part.momentum().threevec();
+  std::array<int, 6> cell;
+  for (int k = 0; k < 3; k++) {
+    cell[k] = std::floor(r[k] / index_dr_);
+    cell[k + 3] = std::floor(p[k] / rp_);
+  }
+  return cell;
+}
+
+void PauliBlocker::insert_into_index(const ParticleData &part) {
+  if (!part.is_baryon()) {
+    return;
+  }
+  const std::uint64_t key = cell_key(part.pdgcode(), cell_of(part));
+  index_[key].push_back(part);
+  index_key_[part.id()] = key;
+}
+
+void PauliBlocker::remove_from_index(const ParticleData &part) {
+  const auto found = index_key_.find(part.id());
+  if (found == index_key_.end()) {
+    return;
+  }
+  ParticleList &cell = index_[found->second];
+  for (auto it = cell.begin(); it != cell.end(); ++it) {
+    if (it->id() == part.id()) {
+      *it = cell.back();
+      cell.pop_back();
+      break;
+    }
+  }
+  index_key_.erase(found);
+}
+
+void PauliBlocker::update_index(const Particles &particles,
+                                double max_displacement) {
+  indexed_particles_ = &particles;
+  index_dr_ = rr_ + rc_ + max_displacement;
+  for (auto &cell : index_) {
+    cell.second.clear();
+  }
+  index_key_.clear();
+  for (const ParticleData &part : particles) {
+    insert_into_index(part);
+  }
+}
+
+void PauliBlocker::update_index(const ParticleList &incoming,
+                                const ParticleList &outgoing) {
+  if (indexed_particles_ == nullptr) {
+    return;
+  }
+  for (const ParticleData &part : incoming) {
+    remove_from_index(part);
+  }
+  for (const ParticleData &part : outgoing) {
+    insert_into_index(part);
+  }
+}
+
 void PauliBlocker::init_weights_analytical() {
   const double pi = M_PI;
   const double sqrt2 = std::sqrt(2.);
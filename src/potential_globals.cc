@@ -12,8 +12,8 @@
 
 namespace smash {
 
-RectangularLattice<FourVector> *UB_lat_pointer = nullptr;
-RectangularLattice<FourVector> *UI3_lat_pointer = nullptr;
-Potentials *pot_pointer = nullptr;
+thread_local RectangularLattice<FourVector> *UB_lat_pointer = nullptr;
+thread_local RectangularLattice<FourVector> *UI3_lat_pointer = nullptr;
+thread_local Potentials *pot_pointer = nullptr;
 
 }  // namespace smash
@@ -9,6 +9,10 @@
 
 #include "smash/propagation.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "smash/boxmodus.h"
 #include "smash/collidermodus.h"
 #include "smash/listmodus.h"
@@ -75,11 +79,12 @@ double propagate_straight_line(Particles *particles, double to_time,
       v = data.velocity();
     }
     const FourVector distance = FourVector(0.0, v * dt);
-    logg[LPropagation].debug("Particle ", data, " motion: ", distance);
     FourVector position = data.position() + distance;
     position.set_x0(to_time);
     data.set_4position(position);
   }
+  logg[LPropagation].debug("Propagated ", particles->size(),
+                           " particles to t = ", to_time, " fm/c.");
   return dt;
 }
 
@@ -87,15 +92,13 @@ void expand_space_time(Particles *particles,
                        const ExperimentParameters &parameters,
                        const ExpansionProperties &metric) {
   const double dt = parameters.labclock->timestep_duration();
+  const double h = calc_hubble(parameters.labclock->current_time(), metric);
   for (ParticleData &data : *particles) {
     // Momentum and position modification to ensure appropriate expansion
-    const double h = calc_hubble(parameters.labclock->current_time(), metric);
     FourVector delta_mom = FourVector(0.0, h * data.momentum().threevec() * dt);
     FourVector expan_dist =
         FourVector(0.0, h * data.position().threevec() * dt);
 
-    logg[LPropagation].debug("Particle ", data,
-                             " expansion motion: ", expan_dist);
     // New position and momentum
     FourVector position = data.position() + expan_dist;
     FourVector momentum = data.momentum() - delta_mom;
@@ -106,24 +109,34 @@ void expand_space_time(Particles *particles,
     // force the on shell condition to ensure correct energy
     data.set_4momentum(data.pole_mass(), data.momentum().threevec());
   }
+  logg[LPropagation].debug("Expanded ", particles->size(),
+                           " particles with Hubble parameter ", h, ".");
 }
 
-void update_momenta(
+double update_momenta(
     Particles *particles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat) {
-  // Copy particles before propagation to calculate potentials from them
-  const ParticleList plist = particles->copy_to_vector();
+  /* The potentials are calculated from the particles before propagation. The
+   * momenta only change in the second pass below, so the copy is only needed
+   * if a force has to be calculated without lattice. */
+  ParticleList plist;
+  bool plist_filled = false;
 
   bool possibly_use_lattice =
       (pot.use_skyrme() ? (FB_lat != nullptr) : true) &&
       (pot.use_symmetry() ? (FI3_lat != nullptr) : true);
   std::pair<ThreeVector, ThreeVector> FB, FI3;
-  double min_time_scale = std::numeric_limits<double>::infinity();
 
-  for (ParticleData &data : *particles) {
+  /* First pass: the forces on all particles, in the order of iteration.
+   * Particles that are not affected by the potentials get no force. */
+  thread_local std::vector<ThreeVector> forces;
+  forces.clear();
+  forces.reserve(particles->size());
+  for (const ParticleData &data : *particles) {
     // Only baryons and nuclei will be affected by the potentials
     if (!(data.is_baryon() || data.is_nucleus())) {
+      forces.emplace_back(0., 0., 0.);
       continue;
     }
     const auto scale = pot.force_scale(data.type());
@@ -142,29 +155,44 @@ void update_momenta(
       FI3 = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
     }
     if (!use_lattice) {
+      if (!plist_filled) {
+        plist = particles->copy_to_vector();
+        plist_filled = true;
+      }
       const auto tmp = pot.all_forces(r, plist);
       FB = std::make_pair(std::get<0>(tmp), std::get<1>(tmp));
       FI3 = std::make_pair(std::get<2>(tmp), std::get<3>(tmp));
     }
-    const ThreeVector Force =
+    forces.push_back(
         scale.first *
             (FB.first + data.momentum().velocity().cross_product(FB.second)) +
         scale.second * data.type().isospin3_rel() *
-            (FI3.first + data.momentum().velocity().cross_product(FI3.second));
-    logg[LPropagation].debug("Update momenta: F [GeV/fm] = ", Force);
+            (FI3.first + data.momentum().velocity().cross_product(FI3.second)));
+  }
+
+  // Second pass: the momentum update, in place.
+  double min_time_scale = std::numeric_limits<double>::infinity();
+  std::size_t i = 0;
+  for (ParticleData &data : *particles) {
+    const ThreeVector &force = forces[i++];
+    if (!(data.is_baryon() || data.is_nucleus())) {
+      continue;
+    }
     data.set_4momentum(data.effective_mass(),
-                       data.momentum().threevec() + Force * dt);
+                       data.momentum().threevec() + force * dt);
 
     // calculate the time scale of the change in momentum
-    const double Force_abs = Force.abs();
-    if (Force_abs < really_small) {
+    const double force_abs = force.abs();
+    if (force_abs < really_small) {
       continue;
     }
-    const double time_scale = data.momentum().x0() / Force_abs;
-    if (time_scale < min_time_scale) {
-      min_time_scale = time_scale;
-    }
+    min_time_scale =
+        std::min(min_time_scale, data.momentum().x0() / force_abs);
   }
+  logg[LPropagation].debug("Updated momenta of ", particles->size(),
+                           " particles, shortest time scale of the momentum "
+                           "change: ",
+                           min_time_scale, " fm/c.");
 
   // warn if the time step is too big
   constexpr double safety_factor = 0.1;
@@ -174,6 +202,7 @@ void update_momenta(
         << "with potentials. Maximum safe value: "
         << safety_factor * min_time_scale << " fm/c.";
   }
+  return min_time_scale;
 }
 
 }  // namespace smash
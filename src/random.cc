@@ -13,7 +13,7 @@
 
 namespace smash {
 static constexpr int LGrandcanThermalizer = LogArea::GrandcanThermalizer::id;
-/*thread_local (see #3075)*/ random::Engine random::engine;
+thread_local random::Engine random::engine;
 
 int64_t random::generate_63bit_seed() {
   std::random_device rd;
@@ -26,6 +26,28 @@ int64_t random::generate_63bit_seed() {
   return seed;
 }
 
+/**
+ * SplitMix64 finalizer, a bijective mixing function of 64-bit integers.
+ *
+ * \param[in] x Value to be mixed.
+ * \return Mixed value.
+ */
+static uint64_t splitmix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+int64_t random::stream_seed(int64_t master_seed, int64_t event_number,
+                            int64_t stream) {
+  uint64_t h = splitmix64(static_cast<uint64_t>(master_seed));
+  h = splitmix64(h ^ static_cast<uint64_t>(event_number));
+  h = splitmix64(h ^ static_cast<uint64_t>(stream));
+  // Discard the highest bit to make sure it fits into a positive int64_t
+  return static_cast<int64_t>(h >> 1);
+}
+
 random::BesselSampler::BesselSampler(const double poisson_mean1,
                                      const double poisson_mean2,
                                      const int fixed_difference)
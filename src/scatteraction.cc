@@ -179,20 +179,18 @@ double ScatterAction::relative_velocity() const {
                             incoming_particles()[1].momentum().x0());
 }
 
-double ScatterAction::transverse_distance_sqr() const {
-  // local copy of particles (since we need to boost them)
-  ParticleData p_a = incoming_particles_[0];
-  ParticleData p_b = incoming_particles_[1];
+double ScatterAction::transverse_distance_sqr(const ParticleData &p_a,
+                                              const ParticleData &p_b) {
   /* Boost particles to center-of-momentum frame. */
-  const ThreeVector velocity = beta_cm();
-  p_a.boost(velocity);
-  p_b.boost(velocity);
+  const ThreeVector velocity = (p_a.momentum() + p_b.momentum()).velocity();
   const ThreeVector pos_diff =
-      p_a.position().threevec() - p_b.position().threevec();
+      p_a.position().lorentz_boost(velocity).threevec() -
+      p_b.position().lorentz_boost(velocity).threevec();
   const ThreeVector mom_diff =
-      p_a.momentum().threevec() - p_b.momentum().threevec();
+      p_a.momentum().lorentz_boost(velocity).threevec() -
+      p_b.momentum().lorentz_boost(velocity).threevec();
 
-  logg[LScatterAction].debug("Particle ", incoming_particles_,
+  logg[LScatterAction].debug("Particles ", p_a.id(), " and ", p_b.id(),
                              " position difference [fm]: ", pos_diff,
                              ", momentum difference [GeV]: ", mom_diff);
 
@@ -216,11 +214,8 @@ double ScatterAction::transverse_distance_sqr() const {
   return result > 0.0 ? result : 0.0;
 }
 
-double ScatterAction::cov_transverse_distance_sqr() const {
-  // local copy of particles (since we need to boost them)
-  ParticleData p_a = incoming_particles_[0];
-  ParticleData p_b = incoming_particles_[1];
-
+double ScatterAction::cov_transverse_distance_sqr(const ParticleData &p_a,
+                                                  const ParticleData &p_b) {
   const FourVector delta_x = p_a.position() - p_b.position();
   const double mom_diff_sqr =
       (p_a.momentum().threevec() - p_b.momentum().threevec()).sqr();
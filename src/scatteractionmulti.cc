@@ -280,7 +280,7 @@ void ScatterActionMulti::generate_final_state() {
 }
 
 double ScatterActionMulti::calculate_I3(const double sqrts) const {
-  static Integrator integrate;
+  static thread_local Integrator integrate;
   const double m1 = incoming_particles_[0].effective_mass();
   const double m2 = incoming_particles_[1].effective_mass();
   const double m3 = incoming_particles_[2].effective_mass();
@@ -11,16 +11,23 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
 #include "smash/logging.h"
+#include "smash/potential_globals.h"
 #include "smash/scatteraction.h"
 #include "smash/scatteractionmulti.h"
 #include "smash/scatteractionphoton.h"
 #include "smash/stringfunctions.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LFindScatter = LogArea::FindScatter::id;
@@ -293,6 +300,216 @@ static constexpr int LFindScatter = LogArea::FindScatter::id;
 
  */
 
+namespace {
+/// Hash of the particles and decay modes for the cached cross section bounds.
+sha256::Hash tabulation_hash = {};
+/// Directory of the cached cross section bounds, empty for no caching.
+bf::path tabulation_path;  // NOLINT(runtime/string)
+}  // unnamed namespace
+
+void ScatterActionsFinder::set_tabulation_directory(
+    sha256::Hash hash, const bf::path& tabulations_path) {
+  tabulation_hash = hash;
+  tabulation_path = tabulations_path;
+}
+
+class ScatterActionsFinder::CrossSectionBounds {
+ public:
+  /**
+   * Prepares empty tabulations for all pairs of stable particle types.
+   *
+   * \param[in] hash Hash of everything the cross sections depend on.
+   */
+  explicit CrossSectionBounds(sha256::Hash hash)
+      : hash_(hash), stable_index_(ParticleType::list_all().size(), -1) {
+    for (const ParticleType& type : ParticleType::list_all()) {
+      if (type.is_stable()) {
+        stable_index_[type_index(type)] = n_stable_++;
+      }
+    }
+    tables_ = std::vector<Table>(n_stable_ * n_stable_);
+  }
+
+  /**
+   * \return The tabulations for the given \p hash, shared with all other
+   * finders that currently use them.
+   *
+   * \param[in] hash Hash of everything the cross sections depend on.
+   */
+  static std::shared_ptr<CrossSectionBounds> shared(sha256::Hash hash) {
+    static std::mutex mutex;
+    static std::map<sha256::Hash, std::weak_ptr<CrossSectionBounds>> bounds;
+    std::lock_guard<std::mutex> guard(mutex);
+    std::weak_ptr<CrossSectionBounds>& entry = bounds[hash];
+    std::shared_ptr<CrossSectionBounds> result = entry.lock();
+    if (!result) {
+      result = std::make_shared<CrossSectionBounds>(hash);
+      entry = result;
+    }
+    return result;
+  }
+
+  /**
+   * See ScatterActionsFinder::cross_section_upper_bound.
+   *
+   * \param[in] data_a First particle.
+   * \param[in] data_b Second particle.
+   * \param[in] finder The finder calculating the cross sections, if the
+   *                   tabulation for this pair has to be created.
+   * \return The upper bound [mb], or a negative value if there is none.
+   */
+  double upper_bound(const ParticleData& data_a, const ParticleData& data_b,
+                     const ScatterActionsFinder& finder) {
+    const ParticleType& type_a = data_a.type();
+    const ParticleType& type_b = data_b.type();
+    Table* const table_pointer = find_table(data_a, data_b);
+    if (table_pointer == nullptr) {
+      return -1.;
+    }
+    Table& table = *table_pointer;
+    std::call_once(table.once, [&]() {
+      table.values = stable_index_[type_index(type_a)] >
+                             stable_index_[type_index(type_b)]
+                         ? tabulate(type_b, type_a, finder)
+                         : tabulate(type_a, type_b, finder);
+    });
+    const double threshold = type_a.mass() + type_b.mass();
+    const double sqrts = (data_a.momentum() + data_b.momentum()).abs();
+    if (sqrts > threshold + range) {
+      return -1.;
+    }
+    return table.values.get_value_step(std::max(sqrts, threshold));
+  }
+
+  /// \return The parameters of the tabulation layout, for hashing.
+  static std::string layout_string() {
+    std::ostringstream layout;
+    layout << range << ' ' << bin_width << ' ' << samples_per_bin
+           << " bin maximum";
+    return layout.str();
+  }
+
+ private:
+  /// Tabulated upper bounds for one pair of types.
+  struct Table {
+    /// Makes sure that the tabulation is created only once.
+    std::once_flag once;
+    /// Upper bound as function of the center of mass energy.
+    Tabulation values;
+  };
+
+  /// Range of the tabulations above the threshold [GeV]
+  static constexpr double range = 6.;
+  /// Bin width of the tabulations [GeV]
+  static constexpr double bin_width = 0.01;
+  /// Number of cross sections evaluated per bin
+  static constexpr int samples_per_bin = 10;
+
+  /// \return The index of \p type in ParticleType::list_all.
+  static std::size_t type_index(const ParticleType& type) {
+    // ParticleType overloads operator&, which returns a ParticleTypePtr
+    return std::addressof(type) - std::addressof(ParticleType::list_all()[0]);
+  }
+
+  /**
+   * \return The tabulation for the types of \p data_a and \p data_b, or
+   * nullptr if there is none, because a particle is unstable or off the
+   * pole mass.
+   *
+   * \param[in] data_a First particle.
+   * \param[in] data_b Second particle.
+   */
+  Table* find_table(const ParticleData& data_a, const ParticleData& data_b) {
+    const ParticleType& type_a = data_a.type();
+    const ParticleType& type_b = data_b.type();
+    int i = stable_index_[type_index(type_a)];
+    int j = stable_index_[type_index(type_b)];
+    if (i < 0 || j < 0 ||
+        std::abs(data_a.effective_mass() - type_a.mass()) > really_small ||
+        std::abs(data_b.effective_mass() - type_b.mass()) > really_small) {
+      return nullptr;
+    }
+    if (i > j) {
+      std::swap(i, j);
+    }
+    return &tables_[i * n_stable_ + j];
+  }
+
+  /**
+   * Creates the tabulation for a pair of types or reads it from the
+   * directory set by set_tabulation_directory.
+   *
+   * \param[in] type_a First type.
+   * \param[in] type_b Second type.
+   * \param[in] finder The finder calculating the cross sections.
+   * \return The tabulated upper bound.
+   */
+  Tabulation tabulate(const ParticleType& type_a, const ParticleType& type_b,
+                      const ScatterActionsFinder& finder) const {
+    bf::path path;
+    if (!tabulation_path.empty()) {
+      // Tables with different parameters must not overwrite each other.
+      path = tabulation_path /
+             ("XS_bound_" + sha256::hash_to_string(hash_) + "_" +
+              type_a.pdgcode().string() + "_" + type_b.pdgcode().string() +
+              ".bin");
+      if (bf::exists(path)) {
+        std::ifstream file(path.string());
+        Tabulation stored = Tabulation::from_file(file, hash_);
+        if (!stored.is_empty()) {
+          return stored;
+        }
+      }
+    }
+    logg[LFindScatter].debug("Tabulating cross section bound for ",
+                             type_a.name(), type_b.name());
+
+    const double threshold = type_a.mass() + type_b.mass();
+    const int n_bins = std::round(range / bin_width);
+    std::vector<double> samples(n_bins * samples_per_bin + 1);
+    for (std::size_t k = 0; k < samples.size(); ++k) {
+      samples[k] = finder.total_cross_section(
+          type_a, type_b, threshold + k * bin_width / samples_per_bin);
+    }
+    // Every bin covers half a bin width on either side of its value.
+    const int last_sample = samples.size() - 1;
+    Tabulation result(threshold, range, n_bins, [&](double sqrts) {
+      const int center = std::round((sqrts - threshold) / bin_width) *
+                         samples_per_bin;
+      const int first = std::max(center - samples_per_bin / 2, 0);
+      const int last = std::min(center + samples_per_bin / 2, last_sample);
+      return *std::max_element(samples.begin() + first,
+                               samples.begin() + last + 1);
+    });
+
+    if (!path.empty()) {
+      // Write to a temporary file first, such that concurrent readers never
+      // see an incomplete tabulation.
+      const bf::path temporary =
+          tabulation_path / bf::unique_path("XS_bound_%%%%-%%%%-%%%%.tmp");
+      {
+        std::ofstream file(temporary.string());
+        result.write(file, hash_);
+      }
+      bf::rename(temporary, path);
+    }
+    return result;
+  }
+
+  /// Hash of everything the cross sections depend on.
+  const sha256::Hash hash_;
+  /// Index of each type among the stable types, -1 for unstable types.
+  std::vector<int> stable_index_;
+  /// Number of stable types.
+  int n_stable_ = 0;
+  /// Tabulations of all pairs of stable types, indexed by their stable index.
+  std::vector<Table> tables_;
+};
+
+constexpr double ScatterActionsFinder::CrossSectionBounds::range;
+constexpr double ScatterActionsFinder::CrossSectionBounds::bin_width;
+constexpr int ScatterActionsFinder::CrossSectionBounds::samples_per_bin;
+
 ScatterActionsFinder::ScatterActionsFinder(
     Configuration config, const ExperimentParameters& parameters,
     const std::vector<bool>& nucleon_has_interacted, int N_tot, int N_proj)
@@ -366,6 +583,60 @@ ScatterActionsFinder::ScatterActionsFinder(
         subconfig.take({"Separate_Fragment_Baryon"}, true),
         subconfig.take({"Popcorn_Rate"}, 0.15));
   }
+
+  if (!is_constant_elastic_isotropic()) {
+    // The bounds depend on the particles, the decay modes and all parameters
+    // entering the cross sections, including the layout of the tabulation.
+    std::ostringstream parameters_string;
+    parameters_string.precision(17);
+    parameters_string << elastic_parameter_ << ' ' << two_to_one_ << ' '
+                      << incl_set_ << ' ' << incl_multi_set_ << ' '
+                      << low_snn_cut_ << ' ' << strings_switch_ << ' '
+                      << use_AQM_ << ' ' << strings_with_probability_ << ' '
+                      << static_cast<int>(nnbar_treatment_) << ' ' << scale_xs_
+                      << ' ' << additional_el_xs_ << ' '
+                      << CrossSectionBounds::layout_string();
+    for (const ParticleType& type : ParticleType::list_all()) {
+      parameters_string << ' ' << type.pdgcode().string() << ' ' << type.mass()
+                        << ' ' << type.width_at_pole();
+    }
+    sha256::Context hash_context;
+    hash_context.update(sha256::hash_to_string(tabulation_hash));
+    hash_context.update(parameters_string.str());
+    cross_section_bounds_ =
+        CrossSectionBounds::shared(hash_context.finalize());
+  }
+}
+
+double ScatterActionsFinder::cross_section_upper_bound(
+    const ParticleData& data_a, const ParticleData& data_b) const {
+  /* The bounds are tabulated without potentials. These shift the thresholds
+   * of the channels in both directions and can therefore also open channels
+   * and increase the cross section. */
+  if (!cross_section_bounds_ || UB_lat_pointer != nullptr ||
+      UI3_lat_pointer != nullptr || pot_pointer != nullptr) {
+    return -1.;
+  }
+  return cross_section_bounds_->upper_bound(data_a, data_b, *this);
+}
+
+double ScatterActionsFinder::total_cross_section(const ParticleType& type_a,
+                                                 const ParticleType& type_b,
+                                                 double sqrts) const {
+  // Only used without potentials, see cross_section_upper_bound.
+  ParticleData a(type_a), b(type_b);
+  const double momentum = pCM(sqrts, type_a.mass(), type_b.mass());
+  a.set_4momentum(type_a.mass(), momentum, 0., 0.);
+  b.set_4momentum(type_b.mass(), -momentum, 0., 0.);
+  ScatterAction act(a, b, 0., isotropic_, string_formation_time_, box_length_);
+  if (strings_switch_) {
+    act.set_string_interface(string_process_interface_.get());
+  }
+  act.add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
+                          incl_multi_set_, low_snn_cut_, strings_switch_,
+                          use_AQM_, strings_with_probability_,
+                          nnbar_treatment_, scale_xs_, additional_el_xs_);
+  return act.cross_section();
 }
 
 ActionPtr ScatterActionsFinder::check_collision_two_part(
@@ -402,6 +673,44 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     return nullptr;
   }
 
+  // Distance squared calculation not needed for stochastic criterion
+  const double distance_squared =
+      (coll_crit_ == CollisionCriterion::Geometric)
+          ? ScatterAction::transverse_distance_sqr(data_a, data_b)
+          : (coll_crit_ == CollisionCriterion::Covariant)
+                ? ScatterAction::cov_transverse_distance_sqr(data_a, data_b)
+                : 0.0;
+
+  /* Don't construct the action and calculate cross sections if the particles
+   * are very far apart or just collided with each other. The cross section
+   * of the pair is bounded by the tabulated bound for its types or else the
+   * maximal cross section, scaled with the formation factors, which are known
+   * before the action is constructed.
+   * Not needed for stochastic criterion because of cell structure. */
+  double xs_bound = -1.;
+  if (coll_crit_ != CollisionCriterion::Stochastic) {
+    double max_distance_squared = max_transverse_distance_sqr(testparticles_);
+    if (distance_squared < max_distance_squared) {
+      xs_bound = cross_section_upper_bound(data_a, data_b);
+      if (xs_bound >= 0.) {
+        max_distance_squared = std::min(
+            max_distance_squared, xs_bound * fm2_mb * M_1_PI / testparticles_);
+      }
+    }
+    max_distance_squared *= data_a.xsec_scaling_factor(time_until_collision) *
+                            data_b.xsec_scaling_factor(time_until_collision);
+    if (distance_squared >= max_distance_squared) {
+      return nullptr;
+    }
+    if (data_a.id_process() > 0 && data_a.id_process() == data_b.id_process()) {
+      logg[LFindScatter].debug("Skipping collided particles at time ",
+                               data_a.position().x0(), " due to process ",
+                               data_a.id_process(), "\n    ", data_a, "\n<-> ",
+                               data_b);
+      return nullptr;
+    }
+  }
+
   // Create ScatterAction object.
   ScatterActionPtr act = make_unique<ScatterAction>(
       data_a, data_b, time_until_collision, isotropic_, string_formation_time_,
@@ -415,19 +724,25 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     act->set_string_interface(string_process_interface_.get());
   }
 
-  // Distance squared calculation not needed for stochastic criterion
-  const double distance_squared =
-      (coll_crit_ == CollisionCriterion::Geometric)
-          ? act->transverse_distance_sqr()
-          : (coll_crit_ == CollisionCriterion::Covariant)
-                ? act->cov_transverse_distance_sqr()
-                : 0.0;
-
-  // Don't calculate cross section if the particles are very far apart.
-  // Not needed for stochastic criterion because of cell structure.
-  if (coll_crit_ != CollisionCriterion::Stochastic &&
-      distance_squared >= max_transverse_distance_sqr(testparticles_)) {
-    return nullptr;
+  /* For the stochastic criterion, the random number is drawn before the
+   * cross sections are calculated. No random numbers are used in between, so
+   * this does not change the outcome. If the number exceeds the probability
+   * for the upper bound of the cross section, the collision does not happen
+   * and its channels are not needed. */
+  double random_no = 0.;
+  if (coll_crit_ == CollisionCriterion::Stochastic) {
+    random_no = random::uniform(0., 1.);
+    xs_bound = cross_section_upper_bound(data_a, data_b);
+    if (xs_bound >= 0.) {
+      const double prob_bound =
+          xs_bound * fm2_mb / static_cast<double>(testparticles_) *
+          data_a.xsec_scaling_factor(time_until_collision) *
+          data_b.xsec_scaling_factor(time_until_collision) *
+          act->relative_velocity() * dt / gcell_vol;
+      if (random_no > prob_bound) {
+        return nullptr;
+      }
+    }
   }
 
   // Add various subprocesses.
@@ -436,6 +751,13 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
                            use_AQM_, strings_with_probability_,
                            nnbar_treatment_, scale_xs_, additional_el_xs_);
 
+  // The criterion below uses the exact cross section in any case.
+  if (xs_bound >= 0. && act->cross_section() > xs_bound) {
+    logg[LFindScatter].debug("Cross section ", act->cross_section(),
+                             " mb above the tabulated bound of ", xs_bound,
+                             " mb\n    ", data_a, "\n<-> ", data_b);
+  }
+
   double xs =
       act->cross_section() * fm2_mb / static_cast<double>(testparticles_);
 
@@ -466,23 +788,12 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     }
 
     // probability criterion
-    double random_no = random::uniform(0., 1.);
     if (random_no > prob) {
       return nullptr;
     }
 
   } else if (coll_crit_ == CollisionCriterion::Geometric ||
              coll_crit_ == CollisionCriterion::Covariant) {
-    // just collided with this particle
-    if (data_a.id_process() > 0 && data_a.id_process() == data_b.id_process()) {
-      logg[LFindScatter].debug("Skipping collided particles at time ",
-                               data_a.position().x0(), " due to process ",
-                               data_a.id_process(), "\n    ", data_a, "\n<-> ",
-                               data_b);
-
-      return nullptr;
-    }
-
     // Cross section for collision criterion
     const double cross_section_criterion = xs * M_1_PI;
 
@@ -571,7 +882,7 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
 }
 
 ActionList ScatterActionsFinder::find_actions_in_cell(
-    const ParticleList& search_list, double dt, const double gcell_vol,
+    const ParticleListView& search_list, double dt, const double gcell_vol,
     const std::vector<FourVector>& beam_momentum) const {
   std::vector<ActionPtr> actions;
   for (const ParticleData& p1 : search_list) {
@@ -603,8 +914,9 @@ ActionList ScatterActionsFinder::find_actions_in_cell(
 }
 
 ActionList ScatterActionsFinder::find_actions_with_neighbors(
-    const ParticleList& search_list, const ParticleList& neighbors_list,
-    double dt, const std::vector<FourVector>& beam_momentum) const {
+    const ParticleListView& search_list,
+    const ParticleListView& neighbors_list, double dt,
+    const std::vector<FourVector>& beam_momentum) const {
   std::vector<ActionPtr> actions;
   if (coll_crit_ == CollisionCriterion::Stochastic) {
     // Only search in cells
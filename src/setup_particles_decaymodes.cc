@@ -10,6 +10,7 @@
 #include "smash/setup_particles_decaymodes.h"
 
 #include "smash/decaymodes.h"
+#include "smash/decaytype.h"
 #include "smash/inputfunctions.h"
 
 #include <boost/filesystem.hpp>
@@ -76,4 +77,25 @@ void load_default_particles_and_decaymodes() {
   ParticleType::check_consistency();
 }
 
+void initialize_physics_tables() {
+  for (const ParticleType &type : ParticleType::list_all()) {
+    type.min_mass_kinematic();
+    type.min_mass_spectral();
+    type.isospin();
+    if (type.is_stable()) {
+      continue;
+    }
+    // initializes the normalization of the spectral function
+    type.spectral_function(type.mass());
+    for (const auto &mode : type.decay_modes().decay_mode_list()) {
+      mode->threshold();
+      mode->type().tabulate();
+    }
+  }
+  // the bounds need the widths of the decay products
+  for (const ParticleType &type : ParticleType::list_all()) {
+    type.tabulate_spectral_ratio_bounds();
+  }
+}
+
 }  // namespace smash
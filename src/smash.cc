@@ -391,6 +391,10 @@ void initialize_particles_and_decays(Configuration &configuration,
   initialize_particles_and_decays(configuration);
   logg[LMain].info("Tabulating cross section integrals...");
   IsoParticleType::tabulate_integrals(hash, tabulations_path);
+  ScatterActionsFinder::set_tabulation_directory(hash, tabulations_path);
+  logg[LMain].info("Tabulating resonance widths and spectral functions...");
+  ParticleType::tabulate_widths(hash, tabulations_path);
+  ParticleType::tabulate_spectral_functions(hash, tabulations_path);
 }
 
 }  // unnamed namespace
@@ -7,6 +7,9 @@
 
 #include "smash/tabulation.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace smash {
 
 Tabulation::Tabulation(double x_min, double range, size_t num,
@@ -53,6 +56,77 @@ double Tabulation::get_value_linear(double x, Extrapolation extrapol) const {
   return values_[n] + (values_[n + 1] - values_[n]) * r;
 }
 
+InverseCdfTabulation::InverseCdfTabulation(double x_min, double range,
+                                           size_t num,
+                                           std::function<double(double)> f)
+    : Tabulation(x_min, range, num, f) {
+  init();
+}
+
+InverseCdfTabulation::InverseCdfTabulation(Tabulation density)
+    : Tabulation(std::move(density)) {
+  assert(!is_empty());
+  init();
+}
+
+void InverseCdfTabulation::init() {
+  const size_t num = values_.size() - 1;
+  const double dx = 1. / inv_dx_;
+  density_.resize(num);
+  cdf_.resize(num + 1);
+  cdf_[0] = 0.;
+  for (size_t i = 0; i < num; i++) {
+    density_[i] = std::max(values_[i], values_[i + 1]);
+    cdf_[i + 1] = cdf_[i] + density_[i] * dx;
+  }
+  guide_.resize(num);
+  size_t i = 0;
+  for (size_t j = 0; j < num; j++) {
+    const double u = cdf_.back() * j / num;
+    while (i < num - 1 && cdf_[i + 1] <= u) {
+      i++;
+    }
+    guide_[j] = i;
+  }
+}
+
+double InverseCdfTabulation::density(double x) const {
+  if (x < x_min_ || x > x_max_) {
+    return 0.;
+  }
+  const size_t i = (x - x_min_) * inv_dx_;
+  return density_[std::min(i, density_.size() - 1)];
+}
+
+double InverseCdfTabulation::cumulative(double x) const {
+  if (x <= x_min_) {
+    return 0.;
+  }
+  if (x >= x_max_) {
+    return cdf_.back();
+  }
+  const double index_double = (x - x_min_) * inv_dx_;
+  const size_t i =
+      std::min(static_cast<size_t>(index_double), density_.size() - 1);
+  return cdf_[i] + density_[i] * (index_double - i) / inv_dx_;
+}
+
+double InverseCdfTabulation::inverse(double u) const {
+  const size_t num = density_.size();
+  const size_t j =
+      std::min(static_cast<size_t>(u / cdf_.back() * num), num - 1);
+  size_t i = guide_[j];
+  while (i < num - 1 && cdf_[i + 1] < u) {
+    i++;
+  }
+  if (!(density_[i] > 0.)) {
+    // only possible for u at the edge of an interval
+    return x_min_ + i / inv_dx_;
+  }
+  const double x = x_min_ + i / inv_dx_ + (u - cdf_[i]) / density_[i];
+  return std::min(x, x_max_);
+}
+
 /**
  * Write binary representation to stream.
  *
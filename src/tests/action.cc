@@ -59,3 +59,16 @@ TEST(finite_momenta) {
   ScatterAction act(a, b, 0.);
   VERIFY(act.transverse_distance_sqr() >= 0.);
 }
+
+// the distances used for rejecting pairs before constructing an action
+TEST(pair_distances) {
+  const auto a =
+      Test::smashon(Position{1., 1., 0.5, 1.}, Momentum{0.3, 0.1, 0.2, -0.05});
+  const auto b =
+      Test::smashon(Position{1., 2., 1., 0.}, Momentum{0.5, -0.2, 0.1, 0.3});
+  ScatterAction act(a, b, 0.);
+  COMPARE(ScatterAction::transverse_distance_sqr(a, b),
+          act.transverse_distance_sqr());
+  COMPARE(ScatterAction::cov_transverse_distance_sqr(a, b),
+          act.cov_transverse_distance_sqr());
+}
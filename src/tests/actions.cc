@@ -56,6 +56,7 @@ TEST(construct_and_insert) {
   actions.insert(std::move(new_actions));
 
   // verify that the actions are in the right order
+  COMPARE(actions.earliest_time(), current_time + time_1);
   COMPARE(actions.pop()->time_of_execution(), current_time + time_1);
   COMPARE(actions.pop()->time_of_execution(), current_time + time_2);
   COMPARE(actions.pop()->time_of_execution(), current_time + time_3);
@@ -65,3 +66,51 @@ TEST(construct_and_insert) {
 
   VERIFY(actions.is_empty());
 }
+
+TEST(remove_invalid) {
+  Particles particles;
+  const ParticleData a = particles.insert(Test::smashon_random());
+  const ParticleData b = particles.insert(Test::smashon_random());
+
+  Actions actions;
+  actions.insert(make_unique<DecayAction>(a, 1.));
+  actions.insert(make_unique<DecayAction>(b, 2.));
+  actions.insert(make_unique<DecayAction>(a, 3.));
+  COMPARE(actions.size(), 3u);
+
+  // nothing happened to the particles yet
+  COMPARE(actions.remove_invalid({a, b}, particles), 0u);
+  COMPARE(actions.size(), 3u);
+
+  // a took part in an action, so its pending actions are gone
+  particles.remove(a);
+  COMPARE(actions.remove_invalid({a}, particles), 2u);
+  COMPARE(actions.size(), 1u);
+  const ActionPtr remaining = actions.pop();
+  COMPARE(remaining->incoming_particles()[0].id(), b.id());
+  VERIFY(actions.is_empty());
+}
+
+TEST(equal_times_in_insertion_order) {
+  const ParticleData p = Test::smashon_random();
+  Actions actions;
+  std::vector<const Action *> inserted;
+  for (int i = 0; i < 20; ++i) {
+    ActionPtr act = make_unique<DecayAction>(p, i % 3 == 0 ? 1. : 2.);
+    inserted.push_back(act.get());
+    actions.insert(std::move(act));
+  }
+  std::vector<const Action *> expected;
+  for (int i = 0; i < 20; i += 3) {
+    expected.push_back(inserted[i]);
+  }
+  for (int i = 0; i < 20; ++i) {
+    if (i % 3 != 0) {
+      expected.push_back(inserted[i]);
+    }
+  }
+  for (const Action *act : expected) {
+    const ActionPtr popped = actions.pop();
+    COMPARE(popped.get(), act);
+  }
+}
@@ -0,0 +1,49 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include <limits>
+#include <stdexcept>
+
+#include "../include/smash/adaptivetimestep.h"
+
+using namespace smash;
+
+static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+TEST(grow_when_dilute) {
+  const AdaptiveTimeStep controller(0.01, 1.0, 0.1, 0.1, 1.5);
+  // no interactions and no potentials: grow by the growth factor ...
+  FUZZY_COMPARE(controller.next_timestep(0.1, infinity, 0, 1000), 0.15);
+  // ... up to the maximum
+  COMPARE(controller.next_timestep(0.9, infinity, 0, 1000), 1.0);
+}
+
+TEST(shrink_when_dense) {
+  const AdaptiveTimeStep controller(0.01, 1.0, 0.1, 0.1, 1.5);
+  // 200 interactions of 1000 particles in 0.5 fm/c: 0.4 per particle and fm/c
+  FUZZY_COMPARE(controller.next_timestep(0.5, infinity, 200, 1000), 0.25);
+  // strong forces limit the time step to a tenth of their time scale
+  FUZZY_COMPARE(controller.next_timestep(0.5, 2.0, 0, 1000), 0.2);
+  // but never below the minimum
+  COMPARE(controller.next_timestep(0.5, 1.e-3, 0, 1000), 0.01);
+}
+
+TEST_CATCH(invalid_minimum, std::invalid_argument) {
+  AdaptiveTimeStep(0., 1., 0.1, 0.1, 1.5);
+}
+
+TEST_CATCH(maximum_below_minimum, std::invalid_argument) {
+  AdaptiveTimeStep(0.1, 0.05, 0.1, 0.1, 1.5);
+}
+
+TEST_CATCH(shrinking_growth_factor, std::invalid_argument) {
+  AdaptiveTimeStep(0.1, 1., 0.1, 0.1, 0.9);
+}
@@ -0,0 +1,81 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../include/smash/allocationpool.h"
+#include "../include/smash/decayaction.h"
+
+using namespace smash;
+
+TEST(reuse_freed_blocks) {
+  void *first = allocation_pool::allocate(100);
+  allocation_pool::deallocate(first, 100);
+  // the same size class gets the freed block back
+  void *second = allocation_pool::allocate(97);
+  COMPARE(second, first);
+  // a different size class does not
+  void *other = allocation_pool::allocate(300);
+  VERIFY(other != second);
+  allocation_pool::deallocate(second, 97);
+  allocation_pool::deallocate(other, 300);
+  // large blocks are not kept, but work as well
+  void *large = allocation_pool::allocate(1 << 20);
+  allocation_pool::deallocate(large, 1 << 20);
+}
+
+TEST(free_on_other_thread) {
+  Test::create_smashon_particletypes();
+  std::vector<ActionPtr> actions;
+  std::thread worker([&actions]() {
+    for (int i = 0; i < 100; ++i) {
+      actions.push_back(make_unique<DecayAction>(Test::smashon_random(), 1.));
+    }
+  });
+  worker.join();
+  // the worker and its free lists are gone, the actions are still usable
+  for (const ActionPtr &act : actions) {
+    COMPARE(act->incoming_particles().size(), 1u);
+  }
+  actions.clear();
+}
+
+TEST(reuse_blocks_freed_on_other_thread) {
+  /* Allocate on short-lived threads and free on this one, like the actions
+   * found on the finder threads. */
+  constexpr int n = 2000;
+  std::vector<void *> blocks(n);
+  std::thread([&blocks]() {
+    for (void *&block : blocks) {
+      block = allocation_pool::allocate(900);
+    }
+  }).join();
+  const std::set<void *> allocated(blocks.begin(), blocks.end());
+  for (void *block : blocks) {
+    allocation_pool::deallocate(block, 900);
+  }
+  // the freed blocks return to the allocating threads
+  std::thread([&blocks]() {
+    for (void *&block : blocks) {
+      block = allocation_pool::allocate(900);
+    }
+  }).join();
+  int reused = 0;
+  for (void *block : blocks) {
+    reused += allocated.count(block);
+    allocation_pool::deallocate(block, 900);
+  }
+  VERIFY(reused > n / 2) << reused;
+}
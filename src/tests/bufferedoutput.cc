@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <string>
+#include <vector>
+
+#include "../include/smash/bufferedoutput.h"
+#include "../include/smash/decayaction.h"
+
+using namespace smash;
+
+namespace {
+/// Output that keeps track of what it receives.
+class MockOutput : public OutputInterface {
+ public:
+  explicit MockOutput(std::string name) : OutputInterface(name) {}
+
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &) override {
+    calls.push_back("start " + std::to_string(event_number));
+    for (const ParticleData &p : particles) {
+      ids.push_back(p.id());
+    }
+  }
+  void at_eventend(const Particles &particles, const int event_number,
+                   const EventInfo &) override {
+    calls.push_back("end " + std::to_string(event_number));
+    n_particles_at_end = particles.size();
+  }
+  void at_interaction(const Action &action, const double density) override {
+    calls.push_back("interaction");
+    interaction_time = action.time_of_execution();
+    interaction_density = density;
+    interaction_type = action.get_type();
+    ids.push_back(action.incoming_particles()[0].id());
+  }
+
+  std::vector<std::string> calls;
+  std::vector<int> ids;
+  size_t n_particles_at_end = 0;
+  double interaction_time = 0.;
+  double interaction_density = 0.;
+  ProcessType interaction_type = ProcessType::None;
+};
+}  // unnamed namespace
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(flags) {
+  MockOutput dileptons("Dileptons");
+  MockOutput photons("Photons");
+  MockOutput ic("SMASH_IC");
+  MockOutput other("Particles");
+  VERIFY(BufferedOutput(dileptons).is_dilepton_output());
+  VERIFY(BufferedOutput(photons).is_photon_output());
+  VERIFY(BufferedOutput(ic).is_IC_output());
+  const BufferedOutput buffer(other);
+  VERIFY(!buffer.is_dilepton_output());
+  VERIFY(!buffer.is_photon_output());
+  VERIFY(!buffer.is_IC_output());
+}
+
+TEST(replay_in_order) {
+  Particles particles;
+  particles.insert(Test::smashon_random());
+  const ParticleData second = particles.insert(Test::smashon_random());
+  const ParticleData third = particles.insert(Test::smashon_random());
+  particles.remove(second);
+
+  MockOutput target("Particles");
+  BufferedOutput buffer(target);
+  const EventInfo info = Test::default_event_info();
+  buffer.at_eventstart(particles, 7, info);
+  DecayAction decay(third, 0.5);
+  buffer.at_interaction(decay, 0.25);
+  particles.reset();
+  buffer.at_eventend(particles, 7, info);
+  VERIFY(target.calls.empty());
+  VERIFY(!buffer.empty());
+
+  buffer.replay_onto(target);
+  VERIFY(buffer.empty());
+  COMPARE(target.calls, (std::vector<std::string>{"start 7", "interaction",
+                                                  "end 7"}));
+  // ids are preserved by the snapshot, also with holes in the list
+  COMPARE(target.ids, (std::vector<int>{0, 2, 2}));
+  COMPARE(target.n_particles_at_end, 0u);
+  COMPARE(target.interaction_time, decay.time_of_execution());
+  COMPARE(target.interaction_density, 0.25);
+  COMPARE(target.interaction_type, decay.get_type());
+}
@@ -11,10 +11,12 @@
 
 #include "setup.h"
 
+#include <limits>
 #include <typeinfo>
 
 #include "../include/smash/cxx14compat.h"
 #include "../include/smash/decayaction.h"
+#include "../include/smash/decayactionsfinder.h"
 #include "../include/smash/decaymodes.h"
 
 using namespace smash;
@@ -126,3 +128,51 @@ TEST(create_decayaction) {
   const auto act = make_unique<DecayAction>(H, time_of_execution);
   std::cout << *act << std::endl;
 }
+
+TEST(schedule_decays) {
+  ParticleData H{ParticleType::find(0x50661)};
+  H.set_4momentum(H.type().mass(), ThreeVector(1.0, 0.0, 0.0));
+  ParticleData A1{ParticleType::find(0x10661)};
+  const DecayActionsFinder finder(1.);
+  // without a time limit, every resonance gets its decay scheduled
+  const double infinity = std::numeric_limits<double>::infinity();
+  ActionList found =
+      finder.find_actions_in_cell(ParticleList{H, A1}, infinity, 0., {});
+  COMPARE(found.size(), 1u);
+  COMPARE(found[0]->incoming_particles()[0].type(), H.type());
+  VERIFY(found[0]->time_of_execution() >= H.position().x0());
+  // a decay can never happen within a vanishing time step
+  found = finder.find_actions_in_cell(ParticleList{H, A1}, 0., 0., {});
+  VERIFY(found.empty());
+}
+
+TEST(decay_widths_buffer) {
+  ParticleData H{ParticleType::find(0x50661)};
+  H.set_4momentum(H.type().mass() + 1.0, ThreeVector(1.0, 0.0, 0.0));
+  const DecayBranchList H_decays = H.type().get_partial_widths(
+      H.momentum(), H.position().threevec(), WhichDecaymodes::All);
+  DecayWidths widths;
+  H.type().get_partial_widths(H.momentum(), H.position().threevec(),
+                              WhichDecaymodes::All, &widths);
+  COMPARE(widths.size(), H.type().decay_modes().decay_mode_list().size());
+  COMPARE(widths.number_of_open_modes(), H_decays.size());
+  double total = 0.;
+  for (std::size_t i = 0; i < H_decays.size(); i++) {
+    COMPARE(widths[i], H_decays[i]->weight());
+    total += widths[i];
+  }
+  FUZZY_COMPARE(widths.total(), total);
+
+  // the executed mode is taken from the decay mode list
+  DecayAction act(H, 0.);
+  act.add_decays(widths);
+  COMPARE(act.total_width(), widths.total());
+  act.generate_final_state();
+  const std::size_t n_out = act.outgoing_particles().size();
+  VERIFY(n_out == 2u || n_out == 3u);
+  bool found = false;
+  for (std::size_t i = 0; i < widths.size(); i++) {
+    found = found || act.get_partial_weight() == widths[i];
+  }
+  VERIFY(found);
+}
@@ -184,7 +184,6 @@ TEST(smearing_factor_rcut_correction) {
   FUZZY_COMPARE(smearing_factor_rcut_correction(4.0), 0.99886601571021467);
 }
 
-// check that analytical and numerical results for gradient of density coincide
 TEST(density_gradient) {
   // create two protons
   ParticleData part1 = create_proton();
@@ -475,3 +474,209 @@ ExperimentParameters par = smash::Test::default_parameters(Ntest);
 out->density_along_line("box_density.dat", plist, par, DensityType::Baryon,
                         lstart, lend, npoints);
 }*/
+
+TEST(tabulated_smearing_kernel) {
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.gaussian_sigma = 1.0;
+  par.gauss_cutoff_in_sigma = 4.0;
+  const DensityParameters exact(par);
+  DensityParameters tabulated(par);
+  const double tolerance = 1.e-6;
+  tabulated.tabulate_kernel(tolerance);
+  for (int i = 0; i < 1000; i++) {
+    const ThreeVector r(random::uniform(-4., 4.), random::uniform(-4., 4.),
+                        random::uniform(-4., 4.));
+    const FourVector p(0., random::uniform(-1., 1.), random::uniform(-1., 1.),
+                       random::uniform(-1., 1.));
+    const double m = 0.938;
+    const FourVector mom(std::sqrt(m * m + p.sqr3()), p.threevec());
+    const auto sf = unnormalized_smearing_factor(r, mom, 1. / m, exact, true);
+    const auto sf_tab =
+        unnormalized_smearing_factor(r, mom, 1. / m, tabulated, true);
+    // the deviation of the kernel is scaled by the gamma factor
+    const double gamma = mom.x0() / m;
+    COMPARE_ABSOLUTE_ERROR(sf_tab.first, sf.first, tolerance * gamma);
+    // the gradient is the smearing factor times a vector
+    for (int k = 0; sf.first > 0. && k < 3; k++) {
+      const double factor = std::abs(sf.second[k] / sf.first);
+      COMPARE_ABSOLUTE_ERROR(sf_tab.second[k], sf.second[k],
+                             1.001 * tolerance * gamma * factor + 1.e-15)
+          << " at r = " << r;
+    }
+  }
+  tabulated.tabulate_kernel(0.);
+  COMPARE(tabulated.kernel(0.5), std::exp(-0.5));
+  bool thrown = false;
+  try {
+    tabulated.tabulate_kernel(-1.);
+  } catch (std::invalid_argument &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
+
+// check that analytical and numerical results for gradient of density coincide
+
+TEST(parallel_lattice_update) {
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.testparticles = 10;
+  par.gaussian_sigma = 1.0;
+  par.gauss_cutoff_in_sigma = 3.0;
+  const DensityParameters dens_par(par);
+  Particles P;
+  for (int i = 0; i < 500; i++) {
+    ParticleData part = create_proton();
+    part.set_4momentum(0.938, random::uniform(-0.5, 0.5),
+                       random::uniform(-0.5, 0.5), random::uniform(-2., 2.));
+    part.set_4position(FourVector(0., random::uniform(-4., 4.),
+                                  random::uniform(-4., 4.),
+                                  random::uniform(-4., 4.)));
+    P.insert(part);
+  }
+  /* Filling the lattice on several threads has to give bitwise identical
+   * results, also for periodic lattices, where particles contribute to
+   * periodic images. */
+  ThreadPool pool(3);
+  for (const bool periodic : {false, true}) {
+    const std::array<double, 3> l{10., 10., 10.};
+    const std::array<int, 3> n{20, 20, 21};
+    const std::array<double, 3> origin{-5., -5., -5.};
+    DensityLattice serial(l, n, origin, periodic,
+                          LatticeUpdate::EveryTimestep);
+    DensityLattice parallel(l, n, origin, periodic,
+                            LatticeUpdate::EveryTimestep);
+    update_lattice(&serial, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+                   dens_par, P, true);
+    update_lattice(&parallel, LatticeUpdate::EveryTimestep,
+                   DensityType::Baryon, dens_par, P, true, &pool);
+    for (size_t i = 0; i < serial.size(); i++) {
+      for (int k = 0; k < 4; k++) {
+        COMPARE(parallel[i].jmu_net()[k], serial[i].jmu_net()[k]);
+      }
+      COMPARE(parallel[i].grad_rho(), serial[i].grad_rho());
+      COMPARE(parallel[i].dj_dt(), serial[i].dj_dt());
+    }
+    VERIFY(serial.node(10, 10, 10).density() > 0.);
+  }
+}
+
+TEST(fused_lattice_update) {
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.testparticles = 10;
+  par.gaussian_sigma = 1.0;
+  par.gauss_cutoff_in_sigma = 3.0;
+  const DensityParameters dens_par(par);
+  Particles P;
+  const PdgCode codes[] = {0x2212, 0x2112, 0x211, -0x2212};
+  for (int i = 0; i < 400; i++) {
+    ParticleData part{ParticleType::find(codes[i % 4])};
+    part.set_4momentum(part.pole_mass(), random::uniform(-0.5, 0.5),
+                       random::uniform(-0.5, 0.5), random::uniform(-1., 1.));
+    part.set_4position(FourVector(0., random::uniform(-3., 3.),
+                                  random::uniform(-3., 3.),
+                                  random::uniform(-3., 3.)));
+    P.insert(part);
+  }
+  const std::array<double, 3> l{8., 8., 8.};
+  const std::array<int, 3> n{16, 16, 16};
+  const std::array<double, 3> origin{-4., -4., -4.};
+  const LatticeUpdate upd = LatticeUpdate::EveryTimestep;
+  const DensityType types[] = {DensityType::Baryon,
+                               DensityType::BaryonicIsospin,
+                               DensityType::Pion, DensityType::Hadron};
+  std::vector<std::unique_ptr<DensityLattice>> separate, fused;
+  std::vector<std::pair<DensityLattice *, DensityType>> fused_list;
+  for (const DensityType type : types) {
+    separate.emplace_back(
+        make_unique<DensityLattice>(l, n, origin, false, upd));
+    fused.emplace_back(make_unique<DensityLattice>(l, n, origin, false, upd));
+    update_lattice(separate.back().get(), upd, type, dens_par, P, true);
+    fused_list.emplace_back(fused.back().get(), type);
+  }
+  // lattices that are missing or not due are left alone
+  fused_list.emplace_back(nullptr, DensityType::Baryon);
+  DensityLattice at_output(l, n, origin, false, LatticeUpdate::AtOutput);
+  fused_list.emplace_back(&at_output, DensityType::Baryon);
+  update_lattices(fused_list, upd, dens_par, P, true);
+
+  for (size_t k = 0; k < separate.size(); k++) {
+    for (size_t i = 0; i < separate[k]->size(); i++) {
+      DensityOnLattice &a = (*separate[k])[i];
+      DensityOnLattice &b = (*fused[k])[i];
+      for (int mu = 0; mu < 4; mu++) {
+        COMPARE(b.jmu_net()[mu], a.jmu_net()[mu]);
+      }
+      COMPARE(b.grad_rho(), a.grad_rho());
+      COMPARE(b.dj_dt(), a.dj_dt());
+    }
+  }
+  COMPARE(at_output.node(8, 8, 8).density(), 0.);
+
+  DensityLattice other(l, {8, 8, 8}, origin, false, upd);
+  fused_list = {{fused.front().get(), DensityType::Baryon},
+                {&other, DensityType::Baryon}};
+  bool thrown = false;
+  try {
+    update_lattices(fused_list, upd, dens_par, P);
+  } catch (std::invalid_argument &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
+
+TEST(lattice_density_by_convolution) {
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.testparticles = 10;
+  par.gaussian_sigma = 1.0;
+  par.gauss_cutoff_in_sigma = 4.0;
+  const DensityParameters dens_par(par);
+  Particles P;
+  for (int i = 0; i < 2000; i++) {
+    ParticleData part{ParticleType::find(0x2212)};
+    part.set_4momentum(part.pole_mass(), random::uniform(-0.3, 0.3),
+                       random::uniform(-0.3, 0.3), random::uniform(-0.3, 0.3));
+    part.set_4position(FourVector(0., random::normal(0., 1.5),
+                                  random::normal(0., 1.5),
+                                  random::normal(0., 1.5)));
+    P.insert(part);
+  }
+  const std::array<double, 3> l{12., 12., 12.};
+  const std::array<int, 3> n{24, 24, 24};
+  const std::array<double, 3> origin{-6., -6., -6.};
+  const LatticeUpdate upd = LatticeUpdate::EveryTimestep;
+  DensityLattice exact(l, n, origin, true, upd);
+  DensityLattice conv(l, n, origin, true, upd);
+  DensityLattice conv_threaded(l, n, origin, true, upd);
+  update_lattice(&exact, upd, DensityType::Baryon, dens_par, P, true);
+  update_lattices_by_convolution({{&conv, DensityType::Baryon}}, upd,
+                                 dens_par, P, true);
+  ThreadPool pool(3);
+  update_lattices_by_convolution({{&conv_threaded, DensityType::Baryon}}, upd,
+                                 dens_par, P, true, &pool);
+
+  const double cell_volume = 0.5 * 0.5 * 0.5;
+  double total = 0.0, max_gradient = 0.0, max_gradient_deviation = 0.0;
+  for (size_t i = 0; i < conv.size(); i++) {
+    DensityOnLattice &a = exact[i];
+    DensityOnLattice &b = conv[i];
+    DensityOnLattice &c = conv_threaded[i];
+    total += b.jmu_net()[0] * cell_volume;
+    for (int k = 0; k < 3; k++) {
+      max_gradient = std::max(max_gradient, std::abs(a.grad_rho()[k]));
+      max_gradient_deviation = std::max(
+          max_gradient_deviation, std::abs(a.grad_rho()[k] - b.grad_rho()[k]));
+    }
+    // the result does not depend on the number of threads
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE(c.jmu_net()[mu], b.jmu_net()[mu]);
+    }
+    COMPARE(c.grad_rho(), b.grad_rho());
+    COMPARE(c.dj_dt(), b.dj_dt());
+  }
+  // on a periodic lattice the deposition conserves the baryon number
+  COMPARE_RELATIVE_ERROR(total, 200., 1.e-10);
+  COMPARE_RELATIVE_ERROR(conv.node(12, 12, 12).density(),
+                         exact.node(12, 12, 12).density(), 0.05);
+  VERIFY(max_gradient_deviation < 0.05 * max_gradient)
+      << max_gradient_deviation << " vs. " << max_gradient;
+}
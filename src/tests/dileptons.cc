@@ -10,9 +10,28 @@
 #include "setup.h"
 
 #include "../include/smash/decayactiondilepton.h"
+#include "../include/smash/decayactionsfinderdilepton.h"
+#include "../include/smash/particles.h"
 
 using namespace smash;
 
+namespace {
+/// Dilepton output that sums up the weights of all shone decays.
+class WeightSum : public OutputInterface {
+ public:
+  WeightSum() : OutputInterface("Dileptons") {}
+  void at_eventstart(const Particles &, const int,
+                     const EventInfo &) override {}
+  void at_eventend(const Particles &, const int, const EventInfo &) override {}
+  void at_interaction(const Action &action, const double) override {
+    sum += action.get_total_weight();
+    n++;
+  }
+  double sum = 0.;
+  int n = 0;
+};
+}  // unnamed namespace
+
 TEST(init_particle_types) {
   // enable debugging output
   create_all_loggers(Configuration(""));
@@ -21,6 +40,7 @@ TEST(init_particle_types) {
       "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
       "π  0.138  7.7e-9 - 111 211\n"
       "η  0.548 1.31e-6 - 221\n"
+      "ρ  0.776 0.149   - 113 213\n"
       "e⁻ 0.000511 0    +  11\n"
       "γ  0        0    +  22\n");
 }
@@ -36,7 +56,11 @@ TEST(init_decay_modes) {
       "0.326   0  π⁰ π⁰ π⁰\n"
       "0.227   0  π⁺ π⁻ π⁰\n"
       "0.046   1  π⁺ π⁻ γ\n"
-      "6.9e-3  0  e⁻ e⁺ γ\n");
+      "6.9e-3  0  e⁻ e⁺ γ\n"
+      "\n"
+      "ρ\n"
+      "1.      1  π π\n"
+      "4.72e-5 0  e⁻ e⁺\n");
 }
 
 TEST(pion_decay) {
@@ -109,3 +133,35 @@ TEST(eta_decay) {
   // (to an accuracy of five percent)
   COMPARE_RELATIVE_ERROR(weight_sum / N_samples, 0.0069, 0.05);
 }
+
+TEST(accumulated_shining) {
+  const ParticleType &type_rho = ParticleType::find(0x113);
+  ParticleData rho{type_rho};
+  rho.set_4momentum(type_rho.mass(), ThreeVector(0.3, 0., 0.));
+  rho.set_4position(FourVector(2., 0., 0., 0.));
+  Particles particles;
+  particles.insert(rho);
+  const DecayActionsFinderDilepton finder;
+
+  // shining once from 0 to 2 fm equals shining at every propagation
+  WeightSum every, once;
+  finder.shine(particles, &every, 2.);
+  finder.shine_accumulated(particles, &once, 0.);
+  COMPARE(every.n, 1);
+  COMPARE(once.n, 1);
+  FUZZY_COMPARE(once.sum, every.sum);
+
+  // only the time since the last shining counts
+  WeightSum rest;
+  finder.shine_accumulated(particles, &rest, 1.5);
+  FUZZY_COMPARE(rest.sum, every.sum / 4.);
+
+  // ... and only the time since the last interaction
+  rho.set_history(1, 1, ProcessType::Decay, 1., {rho});
+  WeightSum destroyed;
+  finder.shine_accumulated(ParticleList{rho}, &destroyed, 0.);
+  FUZZY_COMPARE(destroyed.sum, every.sum / 2.);
+  WeightSum nothing;
+  finder.shine_accumulated(ParticleList{rho}, &nothing, 2.);
+  COMPARE(nothing.n, 0);
+}
@@ -11,12 +11,16 @@
 
 #include <boost/filesystem.hpp>
 
+#include "../include/smash/boxmodus.h"
 #include "../include/smash/collidermodus.h"
 #include "setup.h"
 
 using namespace smash;
 
-TEST(init_particle_types) { Test::create_actual_particletypes(); }
+TEST(init_particle_types) {
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+}
 
 TEST(create_box) {
   VERIFY(!!Test::experiment(
@@ -87,3 +91,40 @@ TEST(access_particles) {
   ParticleList part_list = part->copy_to_vector();
   VERIFY(part_list.size() == 1);
 }
+
+TEST(event_driven_decays_with_wall_crossings) {
+  /* The ω (lifetime about 23 fm/c) crosses the walls of the small box about
+   * once per fm/c. Every crossing must leave the scheduled decay of the
+   * particle alone; an additional decay per crossing would let almost half
+   * of the ω decay within the time evolution. */
+  Configuration config(
+      "General:\n"
+      "  Modus: Box\n"
+      "  Delta_Time: 0.1\n"
+      "  End_Time: 5.0\n"
+      "  Nevents: 1\n"
+      "  Randomseed: 1\n"
+      "Collision_Term:\n"
+      "  No_Collisions: True\n"
+      "  Event_Driven_Decays: True\n"
+      "Modi:\n"
+      "  Box:\n"
+      "    Initial_Condition: \"thermal momenta\"\n"
+      "    Length: 1.0\n"
+      "    Temperature: 0.2\n"
+      "    Start_Time: 0.0\n"
+      "    Init_Multiplicities:\n"
+      "      223: 400\n");
+  boost::filesystem::path output_path(".");
+  auto exp = make_unique<Experiment<BoxModus>>(config, output_path);
+  exp->initialize_new_event(0);
+  exp->run_time_evolution();
+  std::size_t n_omega = 0;
+  for (const ParticleData &p : *exp->particles()) {
+    if (p.pdgcode() == 0x223) {
+      n_omega++;
+    }
+  }
+  // about 84% survive, one decay per wall crossing leaves about 55%
+  VERIFY(n_omega > 300u) << n_omega;
+}
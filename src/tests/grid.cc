@@ -13,7 +13,9 @@
 
 #include "../include/smash/grid.h"
 #include "../include/smash/logging.h"
+#include "../include/smash/threadpool.h"
 
+#include <algorithm>
 #include <set>
 #include <unordered_set>
 
@@ -154,7 +156,7 @@ TEST(grid_construction) {
       auto idsIt = param.ids.begin();
       auto neighbors = param.neighbors;
       grid.iterate_cells(
-          [&](const ParticleList &search) {
+          [&](const ParticleListView &search) {
             auto ids = *idsIt++;
             for (const auto &p : search) {
               COMPARE(ids.erase(p.id()), 1u)
@@ -162,7 +164,7 @@ TEST(grid_construction) {
             }
             COMPARE(ids.size(), 0u);
           },
-          [&](const ParticleList &search, const ParticleList &n) {
+          [&](const ParticleListView &search, const ParticleListView &n) {
             for (const auto &p : search) {
               for (const auto &p2 : n) {
                 COMPARE(neighbors.erase({std::min(p.id(), p2.id()),
@@ -219,7 +221,7 @@ TEST(periodic_grid) {
       std::vector<std::pair<ParticleData, ParticleData>> neighbor_pairs;
 
       grid.iterate_cells(
-          [&](const ParticleList &search) {
+          [&](const ParticleListView &search) {
             for (const ParticleData &p : search) {
               {
                 const auto it = find(list, p);
@@ -240,13 +242,14 @@ TEST(periodic_grid) {
                   const auto it = find(neighbor_pairs, pair);
                   COMPARE(it, neighbor_pairs.end())
                       << "\np: " << p << "\nq: " << q << '\n'
-                      << detailed(search);
+                      << detailed(ParticleList(search.begin(), search.end()));
                   neighbor_pairs.emplace_back(std::move(pair));
                 }
               }
             }
           },
-          [&](const ParticleList &search, const ParticleList &neighbors) {
+          [&](const ParticleListView &search,
+              const ParticleListView &neighbors) {
             // for each particle in neighbors, find the same particle in list
             for (const ParticleData &p : neighbors) {
               const auto it = find(list, p);
@@ -463,3 +466,250 @@ TEST(max_positions_normal_grid) {
   // still generates an out-of-bounds cell index.
   Grid<GridOptions::Normal> grid2(list, testparticles, 1.0);
 }
+
+/**
+ * Records the callbacks of iterate_cells and iterate_cells_parallel per search
+ * cell and verifies that both visit the same cell combinations in the same
+ * order.
+ */
+template <GridOptions Options>
+static void compare_parallel_iteration(const Grid<Options> &grid) {
+  using Calls = std::vector<std::vector<int>>;
+  auto ids = [](const ParticleListView &list) {
+    std::vector<int> result;
+    for (const ParticleData &p : list) {
+      result.push_back(p.id());
+    }
+    return result;
+  };
+  std::vector<Calls> serial;
+  grid.iterate_cells(
+      [&](const ParticleListView &search) { serial.push_back({ids(search)}); },
+      [&](const ParticleListView &, const ParticleListView &neighbors) {
+        serial.back().push_back(ids(neighbors));
+      });
+  COMPARE(serial.size(), std::size_t(grid.total_number_of_cells()));
+
+  for (const int n_threads : {1, 2, 5}) {
+    std::vector<Calls> parallel(grid.total_number_of_cells());
+    ThreadPool pool(n_threads);
+    grid.iterate_cells_parallel(
+        pool,
+        [&](int cell, const ParticleListView &search) {
+          parallel[cell].push_back(ids(search));
+        },
+        [&](int cell, const ParticleListView &,
+            const ParticleListView &neighbors) {
+          parallel[cell].push_back(ids(neighbors));
+        });
+    COMPARE(parallel, serial) << "n_threads = " << n_threads;
+  }
+}
+
+TEST(parallel_iteration) {
+  using Test::Momentum;
+  using Test::Position;
+  const double min_cell_length = minimal_cell_length(1);
+  Particles list;
+  auto random_value = random::make_uniform_distribution(0., 9.99);
+  for (int n = 200; n; --n) {
+    list.insert(Test::smashon(
+        Position{0., random_value(), random_value(), random_value()},
+        Momentum{Test::smashon_mass,
+                 {random_value(), random_value(), random_value()}},
+        n));
+  }
+  compare_parallel_iteration(
+      Grid<GridOptions::Normal>(list, min_cell_length, timestep));
+  compare_parallel_iteration(Grid<GridOptions::PeriodicBoundaries>(
+      make_pair(std::array<double, 3>{0, 0, 0},
+                std::array<double, 3>{10, 10, 10}),
+      list, min_cell_length, timestep));
+}
+
+TEST_CATCH(parallel_iteration_rethrows, std::runtime_error) {
+  Particles list;
+  list.insert(Test::smashon_random());
+  const Grid<GridOptions::Normal> grid(list, minimal_cell_length(1), timestep);
+  ThreadPool pool(3);
+  grid.iterate_cells_parallel(
+      pool,
+      [](int, const ParticleListView &) {
+        throw std::runtime_error("callback failed");
+      },
+      [](int, const ParticleListView &, const ParticleListView &) {});
+}
+
+/// \return the particle ids of every cell, in the order of iterate_cells.
+template <GridOptions Options>
+static std::vector<std::vector<int>> cell_contents(const Grid<Options> &grid) {
+  std::vector<std::vector<int>> contents;
+  grid.iterate_cells(
+      [&](const ParticleListView &search) {
+        contents.emplace_back();
+        for (const ParticleData &p : search) {
+          contents.back().push_back(p.id());
+          // the cells have to show the current state of the particles
+          COMPARE(p.position().x1(), p.id() % 10 + 0.5);
+        }
+      },
+      [](const ParticleListView &, const ParticleListView &) {});
+  return contents;
+}
+
+TEST(update_periodic_grid) {
+  using Test::Position;
+  constexpr double length = 10;
+  const std::pair<std::array<double, 3>, std::array<double, 3>> box = {
+      {0, 0, 0}, {length, length, length}};
+  const double min_cell_length = minimal_cell_length(1);
+  auto random_value = random::make_uniform_distribution(0., 9.99);
+  // the x coordinate encodes the id, to verify that copies are refreshed
+  auto place = [&](ParticleData &p) {
+    p.set_4position(
+        Position{0., p.id() % 10 + 0.5, random_value(), random_value()});
+  };
+  Particles list;
+  for (int n = 0; n < 150; ++n) {
+    ParticleData &p = list.create(PdgCode(Test::smashon_pdg_string));
+    place(p);
+  }
+  Grid<GridOptions::PeriodicBoundaries> grid(box, list, min_cell_length,
+                                             timestep);
+  for (int step = 0; step < 5; ++step) {
+    // move all particles, remove some and create new ones in their place
+    for (ParticleData &p : list) {
+      place(p);
+    }
+    ParticleList to_remove;
+    for (const ParticleData &p : list) {
+      if (p.id() % 7 == step) {
+        to_remove.push_back(p);
+      }
+    }
+    for (const ParticleData &p : to_remove) {
+      list.remove(p);
+    }
+    for (int n = 0; n < 10 + step; ++n) {
+      ParticleData &p = list.create(PdgCode(Test::smashon_pdg_string));
+      place(p);
+    }
+    VERIFY(!grid.update(box, list, min_cell_length, timestep));
+    const Grid<GridOptions::PeriodicBoundaries> fresh(
+        box, list, min_cell_length, timestep);
+    COMPARE(cell_contents(grid), cell_contents(fresh)) << "step " << step;
+  }
+  // a different layout requires filling the cells anew
+  VERIFY(grid.update(box, list, 2 * min_cell_length, timestep));
+  const Grid<GridOptions::PeriodicBoundaries> fresh(
+      box, list, 2 * min_cell_length, timestep);
+  COMPARE(cell_contents(grid), cell_contents(fresh));
+}
+
+TEST(surrounding_particles) {
+  using Test::Position;
+  const double min_cell_length = minimal_cell_length(1);
+  auto random_value = random::make_uniform_distribution(0., 15.);
+  auto place = [&](ParticleData &p) {
+    p.set_4position(
+        Position{0., random_value(), random_value(), random_value()});
+  };
+  Particles list;
+  for (int n = 0; n < 300; ++n) {
+    place(list.create(PdgCode(Test::smashon_pdg_string)));
+  }
+  Grid<GridOptions::Normal> grid(list, min_cell_length, timestep);
+  ParticleList surrounding;
+  for (int action = 0; action < 50; ++action) {
+    // replace two particles by three, partly outside of the grid
+    ParticleList incoming;
+    for (const ParticleData &p : list) {
+      if (incoming.size() < 2 && random_value() < 1.) {
+        incoming.push_back(p);
+      }
+    }
+    ParticleList outgoing(3, ParticleData{ParticleType::find(
+                                 PdgCode(Test::smashon_pdg_string))});
+    for (ParticleData &p : outgoing) {
+      p.set_4position(Position{0., random_value() - 1., random_value(),
+                               random_value() + 1.});
+    }
+    list.replace(incoming, outgoing);
+    grid.replace(incoming, outgoing);
+
+    grid.surrounding_particles(outgoing, list, surrounding);
+    std::vector<int> ids;
+    for (const ParticleData &p : surrounding) {
+      ids.push_back(p.id());
+    }
+    // all particles within one cell length of the search list are found
+    for (const ParticleData &p : list) {
+      const bool is_outgoing = std::any_of(
+          outgoing.begin(), outgoing.end(),
+          [&p](const ParticleData &q) { return q.id() == p.id(); });
+      const bool is_close = std::any_of(
+          outgoing.begin(), outgoing.end(), [&](const ParticleData &q) {
+            return (q.position().threevec() - p.position().threevec()).abs() <
+                   min_cell_length;
+          });
+      const bool found = std::find(ids.begin(), ids.end(), p.id()) != ids.end();
+      if (is_outgoing) {
+        VERIFY(!found);
+      } else if (is_close) {
+        VERIFY(found) << p;
+      }
+    }
+  }
+}
+
+// The bound checks of the cell indices are compiled into the library unless
+// NDEBUG is defined, so these tests exercise them in debug builds.
+
+/// \return the number of particles in all search cells of \p grid.
+template <GridOptions Options>
+static std::size_t count_particles(const Grid<Options> &grid) {
+  std::size_t n = 0;
+  grid.iterate_cells(
+      [&](const ParticleListView &search) { n += search.size(); },
+      [](const ParticleListView &, const ParticleListView &) {});
+  return n;
+}
+
+TEST(bound_checks_of_normal_grid) {
+  Particles list;
+  for (int n = 0; n < 2000; ++n) {
+    ParticleData &p = list.create(PdgCode(Test::smashon_pdg_string));
+    p.set_4position(Test::Position{0., random::uniform(-10., 10.),
+                                   random::uniform(-10., 10.),
+                                   random::uniform(-10., 10.)});
+  }
+  Grid<GridOptions::Normal> grid(list, 1., timestep);
+  COMPARE(count_particles(grid), 2000u);
+  for (ParticleData &p : list) {
+    p.set_4position(p.position() * 0.5);
+  }
+  grid.update(list, 1., timestep);
+  COMPARE(count_particles(grid), 2000u);
+}
+
+TEST(bound_checks_of_periodic_grid) {
+  constexpr double length = 10;
+  const std::pair<std::array<double, 3>, std::array<double, 3>> box = {
+      {0, 0, 0}, {length, length, length}};
+  Particles list;
+  for (int n = 0; n < 2000; ++n) {
+    ParticleData &p = list.create(PdgCode(Test::smashon_pdg_string));
+    p.set_4position(Test::Position{0., random::uniform(0., 9.99),
+                                   random::uniform(0., 9.99),
+                                   random::uniform(0., 9.99)});
+  }
+  Grid<GridOptions::PeriodicBoundaries> grid(box, list, 1., timestep);
+  COMPARE(count_particles(grid), 2000u);
+  for (ParticleData &p : list) {
+    p.set_4position(Test::Position{0., random::uniform(0., 9.99),
+                                   random::uniform(0., 9.99),
+                                   random::uniform(0., 9.99)});
+  }
+  VERIFY(!grid.update(box, list, 1., timestep));
+  COMPARE(count_particles(grid), 2000u);
+}
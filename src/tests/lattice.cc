@@ -50,6 +50,59 @@ TEST(reset) {
   }
 }
 
+TEST(active_tiles) {
+  const std::array<double, 3> l = {20., 20., 20.};
+  const std::array<int, 3> n = {20, 20, 20};
+  const std::array<double, 3> origin = {0., 0., 0.};
+  RectangularLattice<double> lattice(l, n, origin, false,
+                                     LatticeUpdate::EveryTimestep);
+  const std::size_t tile_size = RectangularLattice<double>::tile_size;
+  COMPARE(lattice.number_of_tiles(), (8000 + tile_size - 1) / tile_size);
+  auto n_active = [&]() {
+    std::size_t count = 0;
+    for (std::size_t tile = 0; tile < lattice.number_of_tiles(); tile++) {
+      count += lattice.is_active_tile(tile);
+    }
+    return count;
+  };
+  COMPARE(n_active(), 0u);
+
+  // only the tiles around the point are filled
+  lattice.iterate_in_radius(ThreeVector(3., 3., 3.), 1.5,
+                            [](double &node, int, int, int) { node = 1.; });
+  const std::size_t active = n_active();
+  VERIFY(active > 0u);
+  VERIFY(active < lattice.number_of_tiles());
+  const RectangularLattice<double> &const_lattice = lattice;
+  for (std::size_t i = 0; i < const_lattice.size(); i++) {
+    if (const_lattice[i] != 0.) {
+      VERIFY(lattice.is_active_tile(i / tile_size));
+    }
+  }
+  // const access does not change anything, non-const access marks the tile
+  COMPARE(const_lattice[7999], 0.);
+  COMPARE(n_active(), active);
+  lattice[7999] = 2.;
+  VERIFY(lattice.is_active_tile(7999 / tile_size));
+  RectangularLattice<double> copy = lattice;
+  COMPARE(copy.is_active_tile(7999 / tile_size), true);
+
+  lattice.reset();
+  COMPARE(n_active(), 0u);
+  for (std::size_t i = 0; i < const_lattice.size(); i++) {
+    COMPARE(const_lattice[i], 0.);
+  }
+  // iterating over all nodes might change all of them
+  for (double &node : lattice) {
+    node = 3.;
+  }
+  COMPARE(n_active(), lattice.number_of_tiles());
+  lattice.reset();
+  for (std::size_t i = 0; i < const_lattice.size(); i++) {
+    COMPARE(const_lattice[i], 0.);
+  }
+}
+
 TEST(out_of_bounds) {
   auto lattice1 = create_lattice(true);
   // For periodic lattice nothing is out of bounds
@@ -340,3 +340,32 @@ TEST(update) {
   COMPARE(p.front().position(), FourVector(3, 3, 3, 3));
   COMPARE(p.front().id_process(), 2u);
 }
+
+TEST(list_view) {
+  Particles p;
+  p.create(5, 0x661);
+  std::vector<unsigned> indices;
+  for (const ParticleData &data : p) {
+    if (data.id() % 2 == 0) {
+      indices.push_back(Particles::storage_index(data));
+    }
+  }
+  const ParticleListView of_indices(p, indices);
+  COMPARE(of_indices.size(), 3u);
+  VERIFY(!of_indices.empty());
+  int id = 0;
+  for (const ParticleData &data : of_indices) {
+    COMPARE(data.id(), id);
+    id += 2;
+  }
+  // The view shows the current state of the particles.
+  p.front().set_4position({1, 2, 3, 4});
+  COMPARE(of_indices[0].position(), FourVector(1, 2, 3, 4));
+
+  const ParticleList list = p.copy_to_vector();
+  const ParticleListView of_list = list;
+  COMPARE(of_list.size(), 5u);
+  COMPARE(std::distance(of_list.begin(), of_list.end()), 5);
+  COMPARE(of_list[4].id(), 4);
+  VERIFY(ParticleListView(ParticleList{}).empty());
+}
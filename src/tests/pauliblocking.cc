@@ -19,6 +19,7 @@
 #include "../include/smash/pauliblocking.h"
 #include "../include/smash/potentials.h"
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 
 using namespace smash;
@@ -116,3 +117,62 @@ TEST(phase_space_density_nucleus) {
     std::cout << 0.5 / 100 * i << "  " << f << std::endl;
   }
 }
+
+TEST(indexed_phase_space_density) {
+  Configuration conf = Test::configuration();
+  conf["Collision_Term"]["Pauli_Blocking"]["Spatial_Averaging_Radius"] = 1.86;
+  conf["Collision_Term"]["Pauli_Blocking"]["Momentum_Averaging_Radius"] = 0.08;
+  conf["Collision_Term"]["Pauli_Blocking"]["Gaussian_Cutoff"] = 2.2;
+
+  std::map<PdgCode, int> list = {{0x2212, 79}, {0x2112, 118}};
+  int Ntest = 10;
+  Nucleus Au(list, Ntest);
+  Au.set_parameters_automatic();
+  Au.arrange_nucleons();
+  Au.generate_fermi_momenta();
+
+  Particles part_Au;
+  Au.copy_particles(&part_Au);
+
+  ExperimentParameters param = smash::Test::default_parameters(Ntest);
+  std::unique_ptr<PauliBlocker> pb = make_unique<PauliBlocker>(
+      conf["Collision_Term"]["Pauli_Blocking"], param);
+
+  const PdgCode pdg = 0x2212;
+  const ParticleList disregard;
+  const auto compare_with_full_loop = [&](const PauliBlocker &indexed) {
+    std::unique_ptr<PauliBlocker> full = make_unique<PauliBlocker>(
+        conf["Collision_Term"]["Pauli_Blocking"], param);
+    for (int i = 0; i < 20; i++) {
+      const ThreeVector r(0.3 * i - 3., 0.1 * i, -0.2 * i + 1.);
+      const ThreeVector p(0.0, 0.01 * i - 0.1, 0.02 * i - 0.2);
+      const double f_full = full->phasespace_dens(r, p, part_Au, pdg,
+                                                  disregard);
+      const double f = indexed.phasespace_dens(r, p, part_Au, pdg, disregard);
+      COMPARE_ABSOLUTE_ERROR(f, f_full, 1.e-9) << "at r = " << r;
+    }
+  };
+
+  pb->update_index(part_Au, 0.);
+  compare_with_full_loop(*pb);
+
+  // propagation within the margin keeps the index valid
+  pb->update_index(part_Au, 1.);
+  for (ParticleData &data : part_Au) {
+    const ThreeVector v = data.velocity();
+    data.set_4position(data.position() + FourVector(1., v));
+  }
+  compare_with_full_loop(*pb);
+
+  // replace a proton by one at a different momentum
+  const ParticleData old_proton = *std::find_if(
+      part_Au.begin(), part_Au.end(),
+      [&](const ParticleData &data) { return data.pdgcode() == pdg; });
+  ParticleData new_proton{ParticleType::find(pdg)};
+  new_proton.set_4position(old_proton.position());
+  new_proton.set_4momentum(old_proton.effective_mass(), 0.05, -0.05, 0.1);
+  ParticleList outgoing = {new_proton};
+  part_Au.replace({old_proton}, outgoing);
+  pb->update_index({old_proton}, outgoing);
+  compare_with_full_loop(*pb);
+}
@@ -260,3 +260,40 @@ TEST(propagation_in_test_potential) {
       << "Expected z-component of velocity " << 0 << ", obtained "
       << P2.front().momentum().velocity().x3();
 }
+
+TEST(only_baryons_are_accelerated) {
+  // A potential with a constant force along x.
+  class Constant_Pot : public Potentials {
+   public:
+    Constant_Pot(Configuration conf, const ExperimentParameters& param)
+        : Potentials(conf, param) {}
+
+    std::tuple<ThreeVector, ThreeVector, ThreeVector, ThreeVector> all_forces(
+        const ThreeVector&, const ParticleList&) const override {
+      return std::make_tuple(ThreeVector(0.1, 0., 0.), ThreeVector(),
+                             ThreeVector(), ThreeVector());
+    }
+
+    bool use_skyrme() const override { return true; }
+    bool use_symmetry() const override { return false; }
+  };
+  Configuration conf = Test::configuration();
+  ExperimentParameters param = smash::Test::default_parameters();
+  const Constant_Pot pot(conf["Potentials"], param);
+
+  Particles P;
+  ParticleData pion{ParticleType::find(0x211)};
+  pion.set_4momentum(0.138, 0.3, 0.2, 0.1);
+  P.insert(pion);
+  ParticleData proton = create_proton();
+  proton.set_4momentum(0.938, 0.3, 0.2, 0.1);
+  P.insert(proton);
+
+  update_momenta(&P, 0.5, pot, nullptr, nullptr);
+  // the pion is left untouched, not even the energy is recalculated
+  COMPARE(P.front().momentum(), pion.momentum());
+  FUZZY_COMPARE(P.back().momentum().x1(), 0.35);
+  COMPARE(P.back().momentum().x2(), 0.2);
+  COMPARE(P.back().momentum().x3(), 0.1);
+  FUZZY_COMPARE(P.back().effective_mass(), 0.938);
+}
@@ -10,6 +10,7 @@
 #include <vir/test.h>  // This include has to be first
 
 #include <cinttypes>
+#include <set>
 
 #include "histogram.h"
 
@@ -119,3 +120,24 @@ TEST(beta_a0) {
   test_distribution(N_TEST, 0.001, [&]() { return random::beta_a0(xmin, b); },
                     [&](double x) { return std::pow(1.0 - x, b) / x; });
 }
+
+TEST(stream_seed) {
+  const int64_t master_seed = 42;
+  // deterministic and independent of previous calls or the engine state
+  const int64_t seed_3 = random::stream_seed(master_seed, 3);
+  random::advance();
+  random::stream_seed(master_seed, 2);
+  COMPARE(random::stream_seed(master_seed, 3), seed_3);
+  COMPARE(random::stream_seed(master_seed, 3, 0), seed_3);
+  // different keys give different, non-negative seeds
+  std::set<int64_t> seeds;
+  for (int64_t event = 0; event < 100; event++) {
+    for (int64_t stream = 0; stream < 10; stream++) {
+      const int64_t seed = random::stream_seed(master_seed, event, stream);
+      VERIFY(seed >= 0);
+      seeds.insert(seed);
+    }
+  }
+  COMPARE(seeds.size(), 1000u);
+  VERIFY(random::stream_seed(master_seed + 1, 3) != seed_3);
+}
@@ -12,9 +12,12 @@
 #include "setup.h"
 
 #include "../include/smash/angles.h"
+#include "../include/smash/lattice.h"
+#include "../include/smash/potential_globals.h"
 #include "../include/smash/random.h"
 #include "../include/smash/scatteraction.h"
 #include "../include/smash/scatteractionmulti.h"
+#include "../include/smash/scatteractionsfinder.h"
 #include "Pythia8/Pythia.h"
 
 #include <algorithm>
@@ -512,3 +515,56 @@ TEST(particle_ordering) {
     }
   }
 }
+
+TEST(cross_section_upper_bound) {
+  Configuration config = Test::configuration("");
+  ExperimentParameters exp_par = Test::default_parameters();
+  const std::vector<bool> has_interacted = {};
+  const ScatterActionsFinder finder(config, exp_par, has_interacted, 0, 0);
+  const ParticleTypePtr proton = &ParticleType::find(pdg::p);
+  const ParticleTypePtr pi_m = &ParticleType::find(pdg::pi_m);
+  const ParticleTypePtr pi_p = &ParticleType::find(pdg::pi_p);
+  const ParticleTypePtr K_m = &ParticleType::find(pdg::K_m);
+  const std::vector<std::pair<ParticleTypePtr, ParticleTypePtr>> pairs = {
+      {proton, proton}, {pi_p, proton}, {proton, pi_m}, {K_m, proton},
+      {pi_p, pi_m}};
+  for (const auto& pair : pairs) {
+    ParticleData a{*pair.first}, b{*pair.second};
+    const double threshold = a.pole_mass() + b.pole_mass();
+    for (double sqrts = threshold; sqrts < threshold + 7.; sqrts += 0.0173) {
+      const double p = pCM(sqrts, a.pole_mass(), b.pole_mass());
+      a.set_4momentum(a.pole_mass(), p, 0., 0.);
+      b.set_4momentum(b.pole_mass(), -p, 0., 0.);
+      // same parameters as the default ones of the finder
+      ScatterAction act(a, b, 0.);
+      act.add_all_scatterings(-1., true, Test::all_reactions_included(),
+                              Test::no_multiparticle_reactions(), 0., false,
+                              false, false, NNbarTreatment::NoAnnihilation, 1.,
+                              0.);
+      const double bound = finder.cross_section_upper_bound(a, b);
+      if (sqrts > threshold + 6.) {
+        VERIFY(bound < 0.);
+      } else {
+        VERIFY(bound >= act.cross_section())
+            << a.type().name() << b.type().name() << " at " << sqrts;
+        COMPARE(finder.cross_section_upper_bound(b, a), bound);
+      }
+    }
+  }
+  // no bound for unstable particles
+  ParticleData delta{ParticleType::find(pdg::Delta_pp)};
+  ParticleData proton_data{*proton};
+  delta.set_4momentum(delta.pole_mass(), 0., 0., 1.);
+  proton_data.set_4momentum(proton_data.pole_mass(), 0., 0., -1.);
+  VERIFY(finder.cross_section_upper_bound(delta, proton_data) < 0.);
+  // no bound if the potentials shift the thresholds
+  ParticleData proton_2{*proton};
+  proton_2.set_4momentum(proton_2.pole_mass(), 0., 0., 1.);
+  VERIFY(finder.cross_section_upper_bound(proton_data, proton_2) >= 0.);
+  RectangularLattice<FourVector> UB_lat({10., 10., 10.}, {2, 2, 2},
+                                        {-5., -5., -5.}, false,
+                                        LatticeUpdate::EveryTimestep);
+  UB_lat_pointer = &UB_lat;
+  VERIFY(finder.cross_section_upper_bound(proton_data, proton_2) < 0.);
+  UB_lat_pointer = nullptr;
+}
@@ -271,14 +271,14 @@ TEST(increasing_scaling_factors) {
   const std::vector<bool> has_interacted = {};
   ScatterActionsFinder finder(config, exp_par, has_interacted, 0, 0);
   COMPARE(finder
-              .find_actions_in_cell({p_a, p_b}, 2. * delta_t_coll,
+              .find_actions_in_cell(ParticleList{p_a, p_b}, 2. * delta_t_coll,
                                     grid_cell_vol, {})
               .size(),
           1u);
   // For a Power smaller than alpha, the particles should not collide.
   ParticleData::formation_power_ = alpha + 0.1;
   COMPARE(finder
-              .find_actions_in_cell({p_a, p_b}, 2. * delta_t_coll,
+              .find_actions_in_cell(ParticleList{p_a, p_b}, 2. * delta_t_coll,
                                     grid_cell_vol, {})
               .size(),
           0u);
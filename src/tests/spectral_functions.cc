@@ -12,9 +12,12 @@
 #include "histogram.h"
 #include "setup.h"
 
+#include <boost/filesystem.hpp>
+
 #include "../include/smash/formfactors.h"
 #include "../include/smash/integrate.h"
 #include "../include/smash/kinematics.h"
+#include "../include/smash/sha256.h"
 #include "../include/smash/stringfunctions.h"
 
 using namespace smash;
@@ -90,3 +93,66 @@ TEST(mass_sampling) {
     return res.spectral_function(m) * pcm * bw;
   });
 }
+
+TEST(mass_sampling_with_ratio_bounds) {
+  const ParticleType &res = ParticleType::find(0x12212);
+  res.tabulate_spectral_ratio_bounds();
+  // Dummy reaction NN -> NN(1440) at sqrt(s) = 6 GeV
+  const double sqrts = 6.0;
+  const double mass_stable = 0.938;
+  const int L = 1;
+  const double dm_hist = 0.01;
+  Histogram1d hist(dm_hist);
+  const int N_sample = 1000000;
+  hist.populate(N_sample, [&]() {
+    return res.sample_resonance_mass(mass_stable, sqrts, L);
+  });
+  hist.test([&](double m) {
+    const double pcm = pCM(sqrts, mass_stable, m);
+    const double bw = blatt_weisskopf_sqr(pcm, L);
+    return res.spectral_function(m) * pcm * bw;
+  });
+}
+
+TEST(mass_sampling_tabulated) {
+  ParticleType::tabulate_spectral_functions(sha256::Hash(), bf::path());
+  const ParticleType &res = ParticleType::find(0x12212);
+  /* Dummy reaction NN -> NN(1440) at sqrt(s) = 6 GeV, which also reaches
+   * beyond the tabulation */
+  const double sqrts = 6.0;
+  const double mass_stable = 0.938;
+  const int L = 1;
+  const double dm_hist = 0.01;
+  Histogram1d hist(dm_hist);
+  const int N_sample = 1000000;
+  hist.populate(N_sample, [&]() {
+    return res.sample_resonance_mass(mass_stable, sqrts, L);
+  });
+  hist.test([&](double m) {
+    const double pcm = pCM(sqrts, mass_stable, m);
+    const double bw = blatt_weisskopf_sqr(pcm, L);
+    return res.spectral_function(m) * pcm * bw;
+  });
+}
+
+TEST(mass_sampling_reproducible) {
+  const ParticleType &res = ParticleType::find(0x12212);
+  const ParticleType &delta = ParticleType::find(0x2224);
+  const ParticleType &rho = ParticleType::find(0x113);
+  /* The sampled masses only depend on the random state and not on the
+   * samplings before, such that every event is determined by its seed. */
+  random::set_seed(42);
+  const double m = res.sample_resonance_mass(0.938, 6.0, 1);
+  const auto masses = delta.sample_resonance_masses(rho, 4.0);
+  for (int i = 0; i < 10000; ++i) {
+    const double sqrts = random::uniform(2.1, 20.);
+    res.sample_resonance_mass(0.938, sqrts, i % 3);
+    delta.sample_resonance_mass(0.138, sqrts, i % 3);
+    delta.sample_resonance_masses(rho, sqrts, i % 3);
+  }
+  random::set_seed(42);
+  COMPARE(res.sample_resonance_mass(0.938, 6.0, 1), m);
+  const auto masses_again = delta.sample_resonance_masses(rho, 4.0);
+  COMPARE(masses_again.first, masses.first);
+  COMPARE(masses_again.second, masses.second);
+}
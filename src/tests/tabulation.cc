@@ -89,3 +89,28 @@ TEST(quadratic) {
   // check extrapolated values
   COMPARE_ABSOLUTE_ERROR(tab.get_value_linear(3.), 7.8, error);
 }
+
+TEST(inverse_cdf) {
+  // a linear density, approximated by a step function from above
+  const InverseCdfTabulation tab(0., 10., 10, [](double x) { return x; });
+  FUZZY_COMPARE(tab.density(-1.), 0.);
+  FUZZY_COMPARE(tab.density(0.5), 1.);
+  FUZZY_COMPARE(tab.density(9.5), 10.);
+  FUZZY_COMPARE(tab.density(10.), 10.);
+  FUZZY_COMPARE(tab.density(11.), 0.);
+  FUZZY_COMPARE(tab.cumulative(-1.), 0.);
+  FUZZY_COMPARE(tab.cumulative(2.), 3.);
+  FUZZY_COMPARE(tab.cumulative(2.5), 4.5);
+  FUZZY_COMPARE(tab.cumulative(10.), 55.);
+  FUZZY_COMPARE(tab.cumulative(20.), 55.);
+  // the inverse is exact for the approximated density
+  FUZZY_COMPARE(tab.inverse(0.), 0.);
+  FUZZY_COMPARE(tab.inverse(55.), 10.);
+  for (double x = 0.05; x < 10.; x += 0.1) {
+    COMPARE_ABSOLUTE_ERROR(tab.inverse(tab.cumulative(x)), x, 1E-12) << x;
+  }
+  // the table can be restored from its tabulated values
+  const InverseCdfTabulation copy(
+      Tabulation(0., 10., 10, [](double x) { return x; }));
+  FUZZY_COMPARE(copy.cumulative(7.3), tab.cumulative(7.3));
+}
@@ -0,0 +1,84 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../include/smash/threadpool.h"
+
+using namespace smash;
+
+TEST(run_on_all_threads) {
+  for (const int n_threads : {0, 1, 4}) {
+    ThreadPool pool(n_threads);
+    COMPARE(pool.size(), std::max(n_threads, 1));
+    for (int round = 0; round < 20; round++) {
+      std::atomic<int> calls{0};
+      pool.run([&]() { calls++; });
+      COMPARE(calls.load(), pool.size());
+    }
+  }
+}
+
+TEST(keep_the_threads) {
+  ThreadPool pool(3);
+  std::vector<std::thread::id> ids(3);
+  std::atomic<int> next{0};
+  pool.run([&]() { ids[next++] = std::this_thread::get_id(); });
+  const std::set<std::thread::id> first(ids.begin(), ids.end());
+  COMPARE(first.size(), 3u);
+  next = 0;
+  pool.run([&]() { ids[next++] = std::this_thread::get_id(); });
+  // the same threads run the work again
+  COMPARE(std::set<std::thread::id>(ids.begin(), ids.end()), first);
+}
+
+TEST(distribute_tasks) {
+  ThreadPool pool(4);
+  std::vector<int> done(1000, 0);
+  std::atomic<std::size_t> next_task{0};
+  pool.run([&]() {
+    for (std::size_t i = next_task++; i < done.size(); i = next_task++) {
+      done[i]++;
+    }
+  });
+  for (const int d : done) {
+    COMPARE(d, 1);
+  }
+}
+
+TEST_CATCH(rethrow_from_helper, std::runtime_error) {
+  ThreadPool pool(2);
+  const std::thread::id caller = std::this_thread::get_id();
+  pool.run([&]() {
+    if (std::this_thread::get_id() != caller) {
+      throw std::runtime_error("work failed");
+    }
+  });
+}
+
+TEST(usable_after_failure) {
+  ThreadPool pool(3);
+  bool thrown = false;
+  try {
+    pool.run([]() { throw std::runtime_error("work failed"); });
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+  std::atomic<int> calls{0};
+  pool.run([&]() { calls++; });
+  COMPARE(calls.load(), 3);
+}
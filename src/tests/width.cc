@@ -11,7 +11,12 @@
 
 #include "setup.h"
 
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
 #include "../include/smash/integrate.h"
+#include "../include/smash/sha256.h"
 
 using namespace smash;
 
@@ -137,3 +142,33 @@ TEST(photon_widths) {
   COMPARE_ABSOLUTE_ERROR(phi.get_partial_width(phi.mass(), {&pi0, &photon}),
                          5.4068538571729e-6, err);
 }
+
+TEST(tabulated_widths) {
+  const std::vector<PdgCode> pdgs = {0x2214, 0x12212, 0x113, 0x223};
+  std::vector<std::vector<double>> direct(pdgs.size());
+  for (std::size_t i = 0; i < pdgs.size(); i++) {
+    const ParticleType &t = ParticleType::find(pdgs[i]);
+    for (int k = 0; k < 60; k++) {
+      const double m = 0.3 + k * 0.0333;
+      direct[i].push_back(t.total_width(m));
+    }
+  }
+
+  // no caching without a tabulation directory
+  ParticleType::tabulate_widths(sha256::Hash(), bf::path());
+
+  for (std::size_t i = 0; i < pdgs.size(); i++) {
+    const ParticleType &t = ParticleType::find(pdgs[i]);
+    for (int k = 0; k < 60; k++) {
+      const double m = 0.3 + k * 0.0333;
+      COMPARE_ABSOLUTE_ERROR(t.total_width(m), direct[i][k], 1E-4) << m;
+    }
+    // far above the tabulated range the widths are evaluated directly
+    const double m = t.mass() + 20.;
+    double w = 0.;
+    for (const auto &mode : t.decay_modes().decay_mode_list()) {
+      w += t.partial_width(m, mode.get());
+    }
+    COMPARE(t.total_width(m), w);
+  }
+}
@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/threadpool.h"
+
+namespace smash {
+
+ThreadPool::ThreadPool(int n_threads) {
+  for (int i = 1; i < n_threads; i++) {
+    helpers_.emplace_back([this]() { serve(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &helper : helpers_) {
+    helper.join();
+  }
+}
+
+void ThreadPool::run(const std::function<void()> &work) {
+  if (helpers_.empty()) {
+    work();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    work_ = &work;
+    failure_ = nullptr;
+    busy_ = helpers_.size();
+    generation_++;
+  }
+  wake_.notify_all();
+
+  std::exception_ptr failure;
+  try {
+    work();
+  } catch (...) {
+    failure = std::current_exception();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this]() { return busy_ == 0; });
+  work_ = nullptr;
+  if (!failure) {
+    failure = failure_;
+  }
+  failure_ = nullptr;
+  lock.unlock();
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+void ThreadPool::serve() {
+  std::uint64_t done_generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock,
+               [&]() { return stop_ || generation_ != done_generation; });
+    if (stop_) {
+      return;
+    }
+    done_generation = generation_;
+    const std::function<void()> &work = *work_;
+    lock.unlock();
+
+    std::exception_ptr failure;
+    try {
+      work();
+    } catch (...) {
+      failure = std::current_exception();
+    }
+
+    lock.lock();
+    if (failure && !failure_) {
+      failure_ = failure;
+    }
+    if (--busy_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+}  // namespace smash